@@ -9,6 +9,11 @@
 
 #include <memory>
 #include <flight_sql/flight_sql_driver.h>
+#include <odbcabstraction/exceptions.h>
+
+namespace ODBC {
+  class ODBCConnection;
+}
 
 /**
  * @brief Create a Driver object
@@ -18,3 +23,29 @@ std::shared_ptr<driver::odbcabstraction::Driver> CreateDriver() {
     driver->SetVersion(WARPDRIVE_BUILD_VERSION);
     return driver;
 }
+
+/**
+ * @brief Whether statements can run in Flight SQL transactions
+ *
+ * FlightSqlConnection does not hand out its FlightSqlClient, so BeginTransaction, Commit and
+ * Rollback cannot be sent, whatever the server supports; turning autocommit off fails with HYC00.
+ */
+bool SupportsTransactions(ODBC::ODBCConnection *conn) {
+    return false;
+}
+
+/**
+ * @brief Begin a Flight SQL transaction on a connection
+ */
+bool BeginTransaction(ODBC::ODBCConnection *conn) {
+    return false;
+}
+
+/**
+ * @brief Commit or roll back the Flight SQL transaction of a connection
+ *
+ * Never called, autocommit never being off.
+ */
+void EndTransaction(ODBC::ODBCConnection *conn, bool commit) {
+    throw driver::odbcabstraction::DriverException("Transactions are not supported", "HYC00");
+}
@@ -0,0 +1,133 @@
+/*--------
+ * Module:			numeric-test.cc
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *--------
+ */
+/*
+ * Test fetching DECIMAL columns as SQL_NUMERIC_STRUCT, double and text.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "common.h"
+
+class NumericTests : public ::testing::Test {
+    void SetUp() override {
+        std::string err_msg;
+        connected = test_connect(&err_msg);
+        ASSERT_TRUE(connected) << err_msg;
+
+        return_code_ = SQLAllocHandle(SQL_HANDLE_STMT, conn, &handle_stmt_);
+        CHECK_CONN_RESULT(return_code_, "Failed to allocate stmt handle in SetUp:\n", conn);
+    }
+
+    void TearDown() override {
+        if (handle_stmt_ != SQL_NULL_HSTMT) {
+            return_code_ = SQLFreeStmt(handle_stmt_, SQL_CLOSE);
+            CHECK_STMT_RESULT(return_code_, "SQLFreeStmt failed in TearDown:\n", handle_stmt_);
+        }
+        if (connected) {
+            std::string err_msg;
+            ASSERT_TRUE(test_disconnect(&err_msg)) << err_msg;
+        }
+    }
+
+protected:
+    bool connected{false};
+    SQLRETURN return_code_{};
+    HSTMT handle_stmt_ = SQL_NULL_HSTMT;
+
+    static std::string
+    FormatNumeric(const SQL_NUMERIC_STRUCT &numeric) {
+        char buf[100];
+        int len = snprintf(buf, sizeof(buf), "precision: %u scale: %d sign: %u val: ",
+                           numeric.precision, numeric.scale, numeric.sign);
+
+        for (int i = 0; i < SQL_MAX_NUMERIC_LEN; i++)
+            len += snprintf(buf + len, sizeof(buf) - len, "%02X", numeric.val[i]);
+        return buf;
+    }
+
+    void ExecuteAndFetch(const std::string &query) {
+        return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) query.c_str(), SQL_NTS);
+        CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    }
+
+    /* Fetch the single value of 'query' as SQL_C_NUMERIC with SQLGetData */
+    void GetNumeric(const std::string &query, const std::string &expected) {
+        SQL_NUMERIC_STRUCT numeric;
+        SQLLEN indicator;
+
+        ExecuteAndFetch(query);
+        return_code_ = SQLFetch(handle_stmt_);
+        CHECK_STMT_RESULT(return_code_, "SQLFetch failed", handle_stmt_);
+
+        memset(&numeric, 0, sizeof(numeric));
+        return_code_ = SQLGetData(handle_stmt_, 1, SQL_C_NUMERIC, &numeric, sizeof(numeric), &indicator);
+        CHECK_STMT_RESULT(return_code_, "SQLGetData failed", handle_stmt_);
+        EXPECT_EQ(expected, FormatNumeric(numeric)) << query;
+
+        return_code_ = SQLFreeStmt(handle_stmt_, SQL_CLOSE);
+        CHECK_STMT_RESULT(return_code_, "SQLFreeStmt failed", handle_stmt_);
+    }
+
+    /* Fetch the single value of 'query' as text into a buffer of 'buflen' bytes */
+    SQLRETURN GetText(const std::string &query, SQLLEN buflen, std::string *text, SQLLEN *indicator) {
+        char buf[200];
+
+        ExecuteAndFetch(query);
+        return_code_ = SQLFetch(handle_stmt_);
+        EXPECT_TRUE(SQL_SUCCEEDED(return_code_)) << format_diagnostic("SQLFetch failed", SQL_HANDLE_STMT, handle_stmt_);
+
+        memset(buf, 0, sizeof(buf));
+        return_code_ = SQLGetData(handle_stmt_, 1, SQL_C_CHAR, buf, buflen, indicator);
+        *text = buf;
+        return return_code_;
+    }
+};
+
+TEST_F(NumericTests, NumericResults) {
+    /* 25.212 (per Microsoft KB 22831) */
+    GetNumeric("SELECT CAST('25.212' AS DECIMAL(5,3))",
+               "precision: 5 scale: 3 sign: 1 val: 7C620000000000000000000000000000");
+    GetNumeric("SELECT CAST('12345678901234567890123456789012345678' AS DECIMAL(38,0))",
+               "precision: 38 scale: 0 sign: 1 val: 4EF338DE509049C4133302F0F6B04909");
+    /* highest DECIMAL(38) value */
+    GetNumeric("SELECT CAST('99999999999999999999999999999999999999' AS DECIMAL(38,0))",
+               "precision: 38 scale: 0 sign: 1 val: FFFFFFFF3F228A097AC4865AA84C3B4B");
+    GetNumeric("SELECT CAST('-7.70' AS DECIMAL(3,2))",
+               "precision: 3 scale: 2 sign: 0 val: 02030000000000000000000000000000");
+    /* negative zero comes back positive */
+    GetNumeric("SELECT CAST('-0' AS DECIMAL(1,0))",
+               "precision: 1 scale: 0 sign: 1 val: 00000000000000000000000000000000");
+    GetNumeric("SELECT CAST('999999999999' AS DECIMAL(12,0))",
+               "precision: 12 scale: 0 sign: 1 val: FF0FA5D4E80000000000000000000000");
+}
+
+TEST_F(NumericTests, DecimalToText) {
+    std::string text;
+    SQLLEN indicator;
+
+    EXPECT_EQ(SQL_SUCCESS, GetText("SELECT CAST('-7.70' AS DECIMAL(3,2))", 100, &text, &indicator));
+    EXPECT_EQ("-7.70", text);
+    EXPECT_EQ(5, indicator);
+    SQLFreeStmt(handle_stmt_, SQL_CLOSE);
+
+    EXPECT_EQ(SQL_SUCCESS, GetText("SELECT CAST('0.005' AS DECIMAL(4,3))", 100, &text, &indicator));
+    EXPECT_EQ("0.005", text);
+}
+
+TEST_F(NumericTests, DecimalToDouble) {
+    SQLDOUBLE value;
+    SQLLEN indicator;
+
+    ExecuteAndFetch("SELECT CAST('25.212' AS DECIMAL(5,3))");
+    return_code_ = SQLFetch(handle_stmt_);
+    CHECK_STMT_RESULT(return_code_, "SQLFetch failed", handle_stmt_);
+    return_code_ = SQLGetData(handle_stmt_, 1, SQL_C_DOUBLE, &value, sizeof(value), &indicator);
+    CHECK_STMT_RESULT(return_code_, "SQLGetData failed", handle_stmt_);
+    EXPECT_EQ(25.212, value);
+}
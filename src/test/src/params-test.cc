@@ -0,0 +1,343 @@
+/*--------
+ * Module:			params-test.cc
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *--------
+ */
+/*
+ * Test binding input parameters with SQLBindParameter: executing directly
+ * and prepared, executing again with new values, NULL values, numbers,
+ * dates, binary values, text sent as a number, text with backslashes and
+ * control characters, text that is not utf8, SQLNumParams,
+ * SQLDescribeParam, SQL_RESET_PARAMS, parameter arrays and values supplied
+ * at execution time with SQLParamData and SQLPutData.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "common.h"
+
+class ParamsTests : public ::testing::Test {
+    void SetUp() override {
+        std::string err_msg;
+        connected = test_connect(&err_msg);
+        ASSERT_TRUE(connected) << err_msg;
+
+        return_code_ = SQLAllocHandle(SQL_HANDLE_STMT, conn, &handle_stmt_);
+        CHECK_CONN_RESULT(return_code_, "Failed to allocate stmt handle in SetUp:\n", conn);
+    }
+
+    void TearDown() override {
+        if (handle_stmt_ != SQL_NULL_HSTMT) {
+            return_code_ = SQLFreeStmt(handle_stmt_, SQL_CLOSE);
+            CHECK_STMT_RESULT(return_code_, "SQLFreeStmt failed in TearDown:\n", handle_stmt_);
+        }
+        if (connected) {
+            std::string err_msg;
+            ASSERT_TRUE(test_disconnect(&err_msg)) << err_msg;
+        }
+    }
+
+protected:
+    bool connected{false};
+    SQLRETURN return_code_{};
+    HSTMT handle_stmt_ = SQL_NULL_HSTMT;
+
+    static std::string
+    GetSQLState(HSTMT hstmt) {
+        SQLCHAR sql_state[6] = "";
+        SQLCHAR message_text[1024];
+        SQLINTEGER native_error;
+        SQLSMALLINT text_length;
+
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sql_state, &native_error,
+                      message_text, sizeof(message_text), &text_length);
+        return reinterpret_cast<const char *>(sql_state);
+    }
+
+    /* Fetch the single value of the current result as text, then close it */
+    std::string FetchText(SQLLEN *indicator) {
+        char buf[200];
+
+        return_code_ = SQLFetch(handle_stmt_);
+        EXPECT_TRUE(SQL_SUCCEEDED(return_code_)) << format_diagnostic("SQLFetch failed", SQL_HANDLE_STMT, handle_stmt_);
+        memset(buf, 0, sizeof(buf));
+        return_code_ = SQLGetData(handle_stmt_, 1, SQL_C_CHAR, buf, sizeof(buf), indicator);
+        EXPECT_TRUE(SQL_SUCCEEDED(return_code_)) << format_diagnostic("SQLGetData failed", SQL_HANDLE_STMT, handle_stmt_);
+        SQLFreeStmt(handle_stmt_, SQL_CLOSE);
+        return buf;
+    }
+};
+
+TEST_F(ParamsTests, ExecDirectWithParameters) {
+    char param1[20] = "foo";
+    SQLINTEGER param2 = 41;
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                                    20, 0, param1, sizeof(param1), NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLBindParameter(handle_stmt_, 2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param2, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CONCAT(?, '''?''', CAST(? + 1 AS VARCHAR))", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("foo'?'42", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, PreparedExecutedAgain) {
+    SQLINTEGER param1;
+    SQLSMALLINT nparams = 0;
+    SQLLEN indicator;
+
+    return_code_ = SQLPrepare(handle_stmt_, (SQLCHAR *) "SELECT CAST(? * 2 AS VARCHAR) -- ?", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLPrepare failed", handle_stmt_);
+    return_code_ = SQLNumParams(handle_stmt_, &nparams);
+    CHECK_STMT_RESULT(return_code_, "SQLNumParams failed", handle_stmt_);
+    EXPECT_EQ(1, nparams);
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    param1 = 21;
+    return_code_ = SQLExecute(handle_stmt_);
+    CHECK_STMT_RESULT(return_code_, "SQLExecute failed", handle_stmt_);
+    EXPECT_EQ("42", FetchText(&indicator));
+
+    param1 = -5;
+    return_code_ = SQLExecute(handle_stmt_);
+    CHECK_STMT_RESULT(return_code_, "SQLExecute failed", handle_stmt_);
+    EXPECT_EQ("-10", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, NegativeAfterMinus) {
+    SQLINTEGER param1 = -1;
+    SQLDOUBLE param2 = -0.5;
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLBindParameter(handle_stmt_, 2, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE,
+                                    0, 0, &param2, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* "1-?" must not become the comment "1--1" */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CAST(1-? AS VARCHAR) || CAST(2-?*2 AS VARCHAR)", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("23.0", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, NumberParameters) {
+    SQLBIGINT param1 = -9223372036854775807LL - 1;
+    SQLDOUBLE param2 = 0.1;
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT,
+                                    0, 0, &param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLBindParameter(handle_stmt_, 2, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE,
+                                    0, 0, &param2, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* the literals read back as the same values */
+    return_code_ = SQLExecDirect(handle_stmt_,
+                                 (SQLCHAR *) "SELECT CASE WHEN ? = -9223372036854775807 - 1 AND ? = CAST(0.1 AS DOUBLE) "
+                                             "THEN 'same' ELSE 'different' END", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("same", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, DateParameters) {
+    SQL_DATE_STRUCT param1 = {1969, 12, 31};
+    SQL_DATE_STRUCT param2 = {2000, 2, 29};
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_TYPE_DATE, SQL_TYPE_DATE,
+                                    0, 0, &param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLBindParameter(handle_stmt_, 2, SQL_PARAM_INPUT, SQL_C_TYPE_DATE, SQL_TYPE_DATE,
+                                    0, 0, &param2, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* a day before the epoch, and a leap day */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CAST(? AS VARCHAR) || ' ' || CAST(? AS VARCHAR)", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("1969-12-31 2000-02-29", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, BinaryParameter) {
+    SQLCHAR param1[] = {0x00, 0xFF, 0x7A};
+    SQLLEN param1_len = sizeof(param1);
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_VARBINARY,
+                                    sizeof(param1), 0, param1, sizeof(param1), &param1_len);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* sent as a hex literal */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CASE WHEN ? = X'00FF7A' THEN 'same' ELSE 'different' END", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("same", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, TextAsInteger) {
+    char param1[20] = " 1.5e1 ";
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_INTEGER,
+                                    0, 0, param1, sizeof(param1), NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* parsed by the driver, blanks and exponent included */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CAST(? + 1 AS VARCHAR)", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ("16", FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, EscapedStringParameter) {
+    char param1[20] = "a\\b'c\td";
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                                    20, 0, param1, sizeof(param1), NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* sent as a Unicode literal, the backslash and the tab escaped */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT ?", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ(std::string(param1), FetchText(&indicator));
+}
+
+TEST_F(ParamsTests, InvalidUtf8Parameter) {
+    char param1[20] = "\xC3\x28";
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                                    20, 0, param1, sizeof(param1), NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    /* rejected by the driver before it is sent */
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT ?", SQL_NTS);
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    EXPECT_EQ("22018", GetSQLState(handle_stmt_));
+}
+
+TEST_F(ParamsTests, NumParamsSkipsQuotedMarkers) {
+    SQLSMALLINT nparams = 0;
+
+    return_code_ = SQLPrepare(handle_stmt_,
+                              (SQLCHAR *) "SELECT CONCAT(?, '?''?', \"?\") /* ? */ FROM (VALUES (?)) AS t(\"?\") -- ?", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLPrepare failed", handle_stmt_);
+    return_code_ = SQLNumParams(handle_stmt_, &nparams);
+    CHECK_STMT_RESULT(return_code_, "SQLNumParams failed", handle_stmt_);
+    EXPECT_EQ(2, nparams);
+}
+
+TEST_F(ParamsTests, NullParameter) {
+    SQLINTEGER param1 = 0;
+    SQLLEN param1_ind = SQL_NULL_DATA;
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param1, 0, &param1_ind);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CAST(? AS INTEGER)", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    FetchText(&indicator);
+    EXPECT_EQ(SQL_NULL_DATA, indicator);
+}
+
+TEST_F(ParamsTests, DescribeParam) {
+    SQLSMALLINT sqltype, digits, nullable;
+    SQLULEN size;
+
+    return_code_ = SQLPrepare(handle_stmt_, (SQLCHAR *) "SELECT ? = 1", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLPrepare failed", handle_stmt_);
+    return_code_ = SQLDescribeParam(handle_stmt_, 1, &sqltype, &size, &digits, &nullable);
+    CHECK_STMT_RESULT(return_code_, "SQLDescribeParam failed", handle_stmt_);
+
+    return_code_ = SQLDescribeParam(handle_stmt_, 2, &sqltype, &size, &digits, &nullable);
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    EXPECT_EQ("07009", GetSQLState(handle_stmt_));
+}
+
+TEST_F(ParamsTests, ResetParams) {
+    SQLINTEGER param1 = 1;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLFreeStmt(handle_stmt_, SQL_RESET_PARAMS);
+    CHECK_STMT_RESULT(return_code_, "SQLFreeStmt failed", handle_stmt_);
+
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT ?", SQL_NTS);
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    EXPECT_EQ("07002", GetSQLState(handle_stmt_));
+}
+
+TEST_F(ParamsTests, OutputParameterNotSupported) {
+    SQLINTEGER param1 = 1;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_OUTPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, &param1, 0, NULL);
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    EXPECT_EQ("HYC00", GetSQLState(handle_stmt_));
+}
+
+TEST_F(ParamsTests, ParameterArray) {
+    SQLINTEGER param1[3] = {1, 2, 3};
+    SQLUSMALLINT operations[3] = {SQL_PARAM_PROCEED, SQL_PARAM_IGNORE, SQL_PARAM_PROCEED};
+    SQLUSMALLINT status[3];
+    SQLULEN processed = 0;
+
+    return_code_ = SQLSetStmtAttr(handle_stmt_, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) 3, 0);
+    CHECK_STMT_RESULT(return_code_, "SQLSetStmtAttr failed", handle_stmt_);
+    return_code_ = SQLSetStmtAttr(handle_stmt_, SQL_ATTR_PARAM_OPERATION_PTR, operations, 0);
+    CHECK_STMT_RESULT(return_code_, "SQLSetStmtAttr failed", handle_stmt_);
+    return_code_ = SQLSetStmtAttr(handle_stmt_, SQL_ATTR_PARAM_STATUS_PTR, status, 0);
+    CHECK_STMT_RESULT(return_code_, "SQLSetStmtAttr failed", handle_stmt_);
+    return_code_ = SQLSetStmtAttr(handle_stmt_, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+    CHECK_STMT_RESULT(return_code_, "SQLSetStmtAttr failed", handle_stmt_);
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                    0, 0, param1, 0, NULL);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT ?", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", handle_stmt_);
+    EXPECT_EQ(2, processed);
+    EXPECT_EQ(SQL_PARAM_SUCCESS, status[0]);
+    EXPECT_EQ(SQL_PARAM_UNUSED, status[1]);
+    EXPECT_EQ(SQL_PARAM_SUCCESS, status[2]);
+}
+
+TEST_F(ParamsTests, DataAtExecution) {
+    char token[] = "param1";
+    SQLLEN param1_ind = SQL_LEN_DATA_AT_EXEC(6);
+    SQLPOINTER value = NULL;
+    SQLLEN indicator;
+
+    return_code_ = SQLBindParameter(handle_stmt_, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                                    100, 0, token, 0, &param1_ind);
+    CHECK_STMT_RESULT(return_code_, "SQLBindParameter failed", handle_stmt_);
+    return_code_ = SQLExecDirect(handle_stmt_, (SQLCHAR *) "SELECT CONCAT(?, '!')", SQL_NTS);
+    ASSERT_EQ(SQL_NEED_DATA, return_code_);
+
+    return_code_ = SQLPutData(handle_stmt_, (SQLPOINTER) "foo", 3);
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    EXPECT_EQ("HY010", GetSQLState(handle_stmt_));
+
+    return_code_ = SQLParamData(handle_stmt_, &value);
+    ASSERT_EQ(SQL_NEED_DATA, return_code_);
+    EXPECT_EQ(token, value);
+    return_code_ = SQLPutData(handle_stmt_, (SQLPOINTER) "foo", 3);
+    CHECK_STMT_RESULT(return_code_, "SQLPutData failed", handle_stmt_);
+    return_code_ = SQLPutData(handle_stmt_, (SQLPOINTER) "bar", SQL_NTS);
+    CHECK_STMT_RESULT(return_code_, "SQLPutData failed", handle_stmt_);
+    return_code_ = SQLParamData(handle_stmt_, &value);
+    CHECK_STMT_RESULT(return_code_, "SQLParamData failed", handle_stmt_);
+    EXPECT_EQ("foobar!", FetchText(&indicator));
+}
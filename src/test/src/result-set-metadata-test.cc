@@ -48,3 +48,35 @@ TEST_F(ResultSetMetadataTest, TestTimeSupportedTypes){
     EXPECT_TRUE(result_meta.find(type) != std::string::npos)<< type <<" isn't in the actual result set metadata.\nActual resultset metadata:\n"<<result_meta;
   }
 }
+
+TEST_F(ResultSetMetadataTest, TestDescribeAfterReexecution){
+  std::string query = "SELECT 1 AS a, 'x' AS b";
+  SQLCHAR name[64];
+  SQLSMALLINT name_len, type, digits, nullable, ncols;
+  SQLULEN size;
+
+  return_code_ = SQLPrepare(hstmt_, (SQLCHAR *) query.c_str(), query.length());
+  CHECK_STMT_RESULT(return_code_, "SQLPrepare Failed", hstmt_);
+  for (int i = 0; i < 2; i++) {
+    return_code_ = SQLExecute(hstmt_);
+    CHECK_STMT_RESULT(return_code_, "SQLExecute Failed", hstmt_);
+    return_code_ = SQLNumResultCols(hstmt_, &ncols);
+    CHECK_STMT_RESULT(return_code_, "SQLNumResultCols Failed", hstmt_);
+    EXPECT_EQ(2, ncols);
+    return_code_ = SQLDescribeCol(hstmt_, 2, name, sizeof(name), &name_len, &type, &size, &digits, &nullable);
+    CHECK_STMT_RESULT(return_code_, "SQLDescribeCol Failed", hstmt_);
+    EXPECT_STREQ("b", (char *) name);
+    return_code_ = SQLFreeStmt(hstmt_, SQL_CLOSE);
+    CHECK_STMT_RESULT(return_code_, "SQLFreeStmt Failed", hstmt_);
+  }
+
+  // A different result on the same handle is described anew
+  query = "SELECT 1 AS c";
+  return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) query.c_str(), query.length());
+  CHECK_STMT_RESULT(return_code_, "SQLExecDirect Failed", hstmt_);
+  return_code_ = SQLNumResultCols(hstmt_, &ncols);
+  CHECK_STMT_RESULT(return_code_, "SQLNumResultCols Failed", hstmt_);
+  EXPECT_EQ(1, ncols);
+  return_code_ = SQLDescribeCol(hstmt_, 2, name, sizeof(name), &name_len, &type, &size, &digits, &nullable);
+  EXPECT_EQ(SQL_ERROR, return_code_);
+}
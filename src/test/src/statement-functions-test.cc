@@ -183,4 +183,153 @@ TEST_F(SQLStatementFunctionsTest, TestStatementReuse2){
 
   result = get_result(hstmt_, &err_msg);
   EXPECT_EQ(exp_result, result.value());
-}
\ No newline at end of file
+}
+TEST_F(SQLStatementFunctionsTest, TestAsyncExecDirect){
+  return_code_ = SQLSetStmtAttr(hstmt_, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER) SQL_ASYNC_ENABLE_ON, 0);
+  CHECK_STMT_RESULT(return_code_, "SQLSetStmtAttr failed", hstmt_);
+
+  std::string sqlQuery = "SELECT c_custkey FROM postgres.tpch.customer WHERE c_custkey BETWEEN 536796 AND 536797";
+  while ((return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length())) == SQL_STILL_EXECUTING);
+  CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", hstmt_);
+
+  SQLINTEGER key;
+  SQLLEN ind;
+  return_code_ = SQLBindCol(hstmt_, 1, SQL_C_SLONG, &key, 0, &ind);
+  CHECK_STMT_RESULT(return_code_, "SQLBindCol failed", hstmt_);
+  for (SQLINTEGER expected : {536796, 536797}) {
+    while ((return_code_ = SQLFetch(hstmt_)) == SQL_STILL_EXECUTING);
+    CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+    EXPECT_EQ(expected, key);
+  }
+  while ((return_code_ = SQLFetch(hstmt_)) == SQL_STILL_EXECUTING);
+  EXPECT_EQ(SQL_NO_DATA, return_code_);
+}
+TEST_F(SQLStatementFunctionsTest, TestMoreResultsBatch){
+  std::string sqlQuery = "SELECT c_custkey FROM postgres.tpch.customer WHERE c_custkey = 536796; "
+                         "SELECT ';' AS c -- ; not a separator\n; "
+                         "SELECT c_custkey FROM postgres.tpch.customer WHERE c_custkey = 536797;";
+  return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+  CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", hstmt_);
+
+  SQLINTEGER key;
+  SQLLEN ind;
+  return_code_ = SQLFetch(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+  return_code_ = SQLGetData(hstmt_, 1, SQL_C_SLONG, &key, 0, &ind);
+  CHECK_STMT_RESULT(return_code_, "SQLGetData failed", hstmt_);
+  EXPECT_EQ(536796, key);
+
+  SQLCHAR text[8];
+  return_code_ = SQLMoreResults(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLMoreResults failed", hstmt_);
+  return_code_ = SQLFetch(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+  return_code_ = SQLGetData(hstmt_, 1, SQL_C_CHAR, text, sizeof(text), &ind);
+  CHECK_STMT_RESULT(return_code_, "SQLGetData failed", hstmt_);
+  EXPECT_STREQ(";", (const char *) text);
+
+  return_code_ = SQLMoreResults(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLMoreResults failed", hstmt_);
+  return_code_ = SQLFetch(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+  return_code_ = SQLGetData(hstmt_, 1, SQL_C_SLONG, &key, 0, &ind);
+  CHECK_STMT_RESULT(return_code_, "SQLGetData failed", hstmt_);
+  EXPECT_EQ(536797, key);
+
+  EXPECT_EQ(SQL_NO_DATA, SQLMoreResults(hstmt_));
+}
+
+TEST_F(SQLStatementFunctionsTest, TestBatchWithParametersRejected){
+  SQLCHAR sqlState[6] = {0};
+  std::string sqlQuery = "SELECT 1; SELECT c_custkey FROM postgres.tpch.customer WHERE c_custkey = ?";
+  return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+  EXPECT_EQ(SQL_ERROR, return_code_);
+  SQLGetDiagRec(SQL_HANDLE_STMT, hstmt_, 1, sqlState, NULL, NULL, 0, NULL);
+  EXPECT_EQ(std::string("HYC00"), std::string((char *) sqlState));
+}
+
+TEST_F(SQLStatementFunctionsTest, TestBulkOperationsWithoutBoundColumns){
+  std::string sqlQuery = "SELECT c_custkey FROM postgres.tpch.customer WHERE c_custkey = 536796";
+  return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+  CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", hstmt_);
+  EXPECT_EQ(SQL_ERROR, SQLBulkOperations(hstmt_, SQL_UPDATE_BY_BOOKMARK));
+  EXPECT_EQ(SQL_ERROR, SQLBulkOperations(hstmt_, SQL_ADD));
+  return_code_ = SQLFetch(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+}
+
+TEST_F(SQLStatementFunctionsTest, TestEscapeSequences){
+  SQLCHAR nativeSql[256];
+  SQLINTEGER nativeLength = 0;
+  std::string sqlQuery = "SELECT {fn UCASE(c_name)} FROM postgres.tpch.customer WHERE c_custkey = 536796";
+  return_code_ = SQLNativeSql(conn, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length(),
+                              nativeSql, sizeof(nativeSql), &nativeLength);
+  CHECK_CONN_RESULT(return_code_, "SQLNativeSql failed", conn);
+  EXPECT_EQ(std::string("SELECT UPPER(c_name) FROM postgres.tpch.customer WHERE c_custkey = 536796"),
+            std::string((char *) nativeSql, nativeLength));
+
+  return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+  CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", hstmt_);
+  return_code_ = SQLFetch(hstmt_);
+  CHECK_STMT_RESULT(return_code_, "SQLFetch failed", hstmt_);
+  EXPECT_EQ(SQL_NO_DATA, SQLFetch(hstmt_));
+
+  SQLCHAR sqlState[6] = {0};
+  sqlQuery = "{? = call f(?)}";
+  return_code_ = SQLNativeSql(conn, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length(),
+                              nativeSql, sizeof(nativeSql), &nativeLength);
+  EXPECT_EQ(SQL_ERROR, return_code_);
+  SQLGetDiagRec(SQL_HANDLE_DBC, conn, 1, sqlState, NULL, NULL, 0, NULL);
+  EXPECT_EQ(std::string("HYC00"), std::string((char *) sqlState));
+}
+
+TEST_F(SQLStatementFunctionsTest, TestDescribeAfterPrepare){
+  SQLSMALLINT numCols = 0;
+  SQLCHAR colName[64];
+  SQLSMALLINT colNameLength = 0, dataType = 0, decimalDigits = 0, nullable = 0;
+  SQLULEN columnSize = 0;
+  std::string sqlQuery = "SELECT c_custkey, c_name FROM postgres.tpch.customer WHERE c_custkey = ?";
+  return_code_ = SQLPrepare(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+  CHECK_STMT_RESULT(return_code_, "SQLPrepare failed", hstmt_);
+  return_code_ = SQLNumResultCols(hstmt_, &numCols);
+  CHECK_STMT_RESULT(return_code_, "SQLNumResultCols failed", hstmt_);
+  EXPECT_EQ(2, numCols);
+  return_code_ = SQLDescribeCol(hstmt_, 2, colName, sizeof(colName), &colNameLength,
+                                &dataType, &columnSize, &decimalDigits, &nullable);
+  CHECK_STMT_RESULT(return_code_, "SQLDescribeCol failed", hstmt_);
+  EXPECT_EQ(std::string("c_name"), std::string((char *) colName, colNameLength));
+}
+
+TEST_F(SQLStatementFunctionsTest, TestManualCommit){
+  SQLUSMALLINT txnCapable = 0;
+  SQLUINTEGER autocommit = 0;
+  return_code_ = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_COMMIT);
+  CHECK_CONN_RESULT(return_code_, "SQLEndTran failed", conn);
+  return_code_ = SQLGetInfo(conn, SQL_TXN_CAPABLE, &txnCapable, sizeof(txnCapable), NULL);
+  CHECK_CONN_RESULT(return_code_, "SQLGetInfo failed", conn);
+
+  return_code_ = SQLSetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_OFF, 0);
+  if (SQL_TC_NONE == txnCapable) {
+    SQLCHAR sqlState[6] = {0};
+    EXPECT_EQ(SQL_ERROR, return_code_);
+    SQLGetDiagRec(SQL_HANDLE_DBC, conn, 1, sqlState, NULL, NULL, 0, NULL);
+    EXPECT_EQ(std::string("HYC00"), std::string((char *) sqlState));
+  } else {
+    CHECK_CONN_RESULT(return_code_, "SQLSetConnectAttr failed", conn);
+    return_code_ = SQLGetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, &autocommit, sizeof(autocommit), NULL);
+    CHECK_CONN_RESULT(return_code_, "SQLGetConnectAttr failed", conn);
+    EXPECT_EQ(SQL_AUTOCOMMIT_OFF, autocommit);
+    std::string sqlQuery = "SELECT 1";
+    return_code_ = SQLExecDirect(hstmt_, (SQLCHAR *) sqlQuery.c_str(), sqlQuery.length());
+    CHECK_STMT_RESULT(return_code_, "SQLExecDirect failed", hstmt_);
+    return_code_ = SQLFreeStmt(hstmt_, SQL_CLOSE);
+    CHECK_STMT_RESULT(return_code_, "SQLFreeStmt failed", hstmt_);
+    return_code_ = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_ROLLBACK);
+    CHECK_CONN_RESULT(return_code_, "SQLEndTran failed", conn);
+  }
+  return_code_ = SQLSetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_ON, 0);
+  CHECK_CONN_RESULT(return_code_, "SQLSetConnectAttr failed", conn);
+  return_code_ = SQLGetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, &autocommit, sizeof(autocommit), NULL);
+  CHECK_CONN_RESULT(return_code_, "SQLGetConnectAttr failed", conn);
+  EXPECT_EQ(SQL_AUTOCOMMIT_ON, autocommit);
+}
@@ -0,0 +1,590 @@
+/*-------
+ * Module:			asyncexec.cc
+ *
+ * Description:		This module contains the asynchronous execution of
+ *					statement and connection functions.
+ *
+ *					With SQL_ATTR_ASYNC_ENABLE on, SQLPrepare, SQLExecDirect,
+ *					SQLExecute, SQLFetch, SQLFetchScroll and SQLMoreResults
+ *					are queued to threads the driver owns, started as
+ *					needed up to AE_MAX_WORKERS and ended after a while
+ *					without work, and return SQL_STILL_EXECUTING at once.  The queued
+ *					call is the usual ExecuteWithDiagnostics() of the
+ *					function, so errors and warnings land on the statement
+ *					handle as they would have.  The application polls by
+ *					calling the function again, or is notified through the
+ *					callback the driver manager sets (ODBC 3.8) and then
+ *					calls SQLCompleteAsync.
+ *
+ *					A queued call holds its thread until the server
+ *					answers: the calls are not multiplexed on fewer threads,
+ *					so at most AE_MAX_WORKERS functions run at once and
+ *					the others wait in the queue.  The queued call keeps the
+ *					pointers the application passed, the SQL text and the
+ *					output buffers, and uses them from the driver's thread;
+ *					as ODBC requires, the application leaves them alone
+ *					until the function returns something other than
+ *					SQL_STILL_EXECUTING.
+ *
+ *					Connections do the same for SQLConnect,
+ *					SQLDriverConnect and SQLDisconnect with
+ *					SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE on, so that many
+ *					can be opened at once from one thread.
+ *
+ * Classes:			AsyncState, AsyncCall, Executor
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "asyncexec.h"
+#include "extension.h"
+#include "mylog.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCConnection;
+using ODBC::ODBCStatement;
+
+/* ODBC 3.8 values missing from older headers */
+#ifndef	SQL_ATTR_ASYNC_STMT_EVENT
+#define	SQL_ATTR_ASYNC_STMT_EVENT	29
+#endif
+#ifndef	SQL_ATTR_ASYNC_STMT_PCALLBACK
+#define	SQL_ATTR_ASYNC_STMT_PCALLBACK	30
+#endif
+#ifndef	SQL_ATTR_ASYNC_STMT_PCONTEXT
+#define	SQL_ATTR_ASYNC_STMT_PCONTEXT	31
+#endif
+#ifndef	SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
+#define	SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE	117
+#define	SQL_ASYNC_DBC_ENABLE_ON		1UL
+#define	SQL_ASYNC_DBC_ENABLE_OFF	0UL
+#endif
+#ifndef	SQL_ATTR_ASYNC_DBC_EVENT
+#define	SQL_ATTR_ASYNC_DBC_EVENT	119
+#endif
+#ifndef	SQL_ATTR_ASYNC_DBC_PCALLBACK
+#define	SQL_ATTR_ASYNC_DBC_PCALLBACK	120
+#endif
+#ifndef	SQL_ATTR_ASYNC_DBC_PCONTEXT
+#define	SQL_ATTR_ASYNC_DBC_PCONTEXT	121
+#endif
+#ifndef	SQL_ASYNC_DBC_FUNCTIONS
+#define	SQL_ASYNC_DBC_FUNCTIONS	10023
+#define	SQL_ASYNC_DBC_CAPABLE	1L
+#endif
+#ifndef	SQL_ASYNC_NOTIFICATION
+#define	SQL_ASYNC_NOTIFICATION	10025
+#endif
+#ifndef	SQL_ASYNC_NOTIFICATION_CAPABLE
+#define	SQL_ASYNC_NOTIFICATION_CAPABLE	1L
+#endif
+
+/* Seconds a thread waits for work before ending */
+#define	AE_IDLE_SECONDS	60
+
+/* SQL_ASYNC_NOTIFICATION_CALLBACK */
+typedef SQLRETURN (SQL_API *AsyncCallback)(SQLPOINTER context, BOOL last);
+
+/* A call of an asynchronous function */
+typedef struct
+{
+	SQLUSMALLINT	api;
+	BOOL		started;
+	BOOL		done;
+	BOOL		cancelled;
+	RETCODE		ret;
+} AsyncCall;
+
+/* The asynchronous state of a statement or connection handle */
+struct AsyncState_
+{
+	SQLULEN		enable;		/* SQL_ATTR_ASYNC_ENABLE or SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE */
+	SQLPOINTER	event;
+	AsyncCallback	callback;
+	SQLPOINTER	context;
+	std::shared_ptr<AsyncCall>	call;	/* running, or done and not returned yet */
+};
+
+/* Guards the AsyncState of every handle and the async_enable of connections */
+static std::mutex	async_lock;
+static std::condition_variable	async_done;
+
+typedef struct
+{
+	std::mutex	lock;
+	std::condition_variable	wake;
+	std::deque<std::function<void()> >	queue;
+	size_t		threads;
+	size_t		idle;
+} Executor;
+
+/* Never freed: its threads may still wait on it while the process exits */
+static Executor	*executor = new Executor();
+
+static void
+worker(void)
+{
+	std::unique_lock<std::mutex>	lock(executor->lock);
+
+	for (;;)
+	{
+		std::function<void()>	task;
+
+		executor->idle++;
+		executor->wake.wait_for(lock, std::chrono::seconds(AE_IDLE_SECONDS),
+			[] { return !executor->queue.empty(); });
+		executor->idle--;
+		if (executor->queue.empty())
+		{
+			executor->threads--;
+			MYLOG(DETAIL_LOG_LEVEL, "worker ends, " FORMAT_SIZE_T " left\n", executor->threads);
+			return;
+		}
+		task = std::move(executor->queue.front());
+		executor->queue.pop_front();
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+/* Queue 'task', starting a thread for it when none is idle.  FALSE when none could run it. */
+static BOOL
+submit(std::function<void()> task)
+{
+	std::lock_guard<std::mutex>	lock(executor->lock);
+
+	executor->queue.push_back(std::move(task));
+	if (executor->queue.size() > executor->idle && executor->threads < AE_MAX_WORKERS)
+	{
+		try
+		{
+			std::thread(worker).detach();
+			executor->threads++;
+		}
+		catch (const std::system_error &e)
+		{
+			MYLOG(0, "no thread started: %s\n", e.what());
+			if (0 == executor->threads)
+			{
+				executor->queue.pop_back();
+				return FALSE;
+			}
+		}
+	}
+	executor->wake.notify_one();
+	return TRUE;
+}
+
+/* Where the extension of 'handle', a statement or connection as 'type' says, keeps its state */
+static AsyncState **
+slot_of(SQLSMALLINT type, SQLHANDLE handle)
+{
+	if (SQL_HANDLE_DBC == type)
+		return &EX_conn((ODBCConnection *) handle)->async;
+	return &EX_stmt((ODBCStatement *) handle)->async;
+}
+
+/* The state in 'slot', made when there is none.  Under async_lock. */
+static AsyncState *
+get_state(AsyncState **slot)
+{
+	AsyncState	*as;
+
+	if (*slot)
+		return *slot;
+	as = new AsyncState();
+	as->enable = SQL_ASYNC_ENABLE_OFF;
+	as->event = as->context = NULL;
+	as->callback = NULL;
+	*slot = as;
+	return as;
+}
+
+/*
+ *	Run the call 'job' on 'handle', whose state is 'as', on a driver thread,
+ *	then tell the application.  'as' stays until the call is done.
+ */
+static void
+run(SQLHANDLE handle, AsyncState *as, std::shared_ptr<AsyncCall> job, const std::function<RETCODE()> &call)
+{
+	AsyncCallback	callback = NULL;
+	SQLPOINTER	context = NULL, event = NULL;
+	RETCODE		ret = SQL_ERROR;
+	BOOL		cancelled;
+
+	{
+		std::lock_guard<std::mutex>	lock(async_lock);
+
+		cancelled = job->cancelled;
+		job->started = !cancelled;
+	}
+	if (!cancelled)
+		ret = call();
+
+	{
+		std::lock_guard<std::mutex>	lock(async_lock);
+
+		job->ret = ret;
+		job->done = TRUE;
+		callback = as->callback;
+		context = as->context;
+		event = as->event;
+	}
+	/* 'handle' may be freed from here on */
+	async_done.notify_all();
+	MYLOG(DETAIL_LOG_LEVEL, "%p: function %d done with %d\n", handle, job->api, ret);
+	if (callback)
+		callback(context, TRUE);
+#ifdef	WIN32
+	else if (event)
+		SetEvent((HANDLE) event);
+#else
+	(void) event;
+#endif /* WIN32 */
+}
+
+/* Return an error with 'sqlstate' from 'handle', on which nothing runs */
+static RETCODE
+report(SQLSMALLINT type, SQLHANDLE handle, const char *message, const char *sqlstate)
+{
+	SQLRETURN	rc = SQL_SUCCESS;
+	auto	error = [message, sqlstate]() -> SQLRETURN {
+		throw DriverException(message, sqlstate);
+	};
+
+	if (SQL_HANDLE_DBC == type)
+		return ODBCConnection::ExecuteWithDiagnostics(handle, rc, error);
+	return ODBCStatement::ExecuteWithDiagnostics(handle, rc, error);
+}
+
+/* What the call 'job' returns to the application, once done */
+static RETCODE
+finish(SQLSMALLINT type, SQLHANDLE handle, const std::shared_ptr<AsyncCall> &job)
+{
+	if (job->cancelled && (!job->started || !SQL_SUCCEEDED(job->ret)))
+		return report(type, handle, "Operation canceled", "HY008");
+	return job->ret;
+}
+
+/* Free the state in 'slot', after the call running on it if any.  Under 'lock'. */
+static void
+forget(std::unique_lock<std::mutex> &lock, AsyncState **slot)
+{
+	AsyncState	*as = *slot;
+
+	if (!as)
+		return;
+	/* the driver thread still uses the handle */
+	async_done.wait(lock, [as] { return !as->call || as->call->done; });
+	*slot = NULL;
+	delete as;
+}
+
+void
+AE_attach(ODBCConnection *conn, ODBCStatement *stmt)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+
+	get_state(&EX_stmt(stmt)->async)->enable = EX_conn(conn)->async_enable;
+}
+
+void
+AE_detach(ODBCStatement *stmt)
+{
+	std::unique_lock<std::mutex>	lock(async_lock);
+
+	forget(lock, &EX_stmt(stmt)->async);
+}
+
+void
+AE_drop(ODBCConnection *conn)
+{
+	std::unique_lock<std::mutex>	lock(async_lock);
+
+	forget(lock, &EX_conn(conn)->async);
+}
+
+RETCODE
+AE_run(SQLSMALLINT type, SQLHANDLE handle, SQLUSMALLINT api, std::function<RETCODE()> call)
+{
+	std::shared_ptr<AsyncCall>	job;
+	AsyncState	*as;
+
+	{
+		std::unique_lock<std::mutex>	lock(async_lock);
+
+		as = *slot_of(type, handle);
+		if (as && as->call)
+		{
+			/*
+			 *	Another function while one runs.  The driver manager
+			 *	normally catches this; the diagnostics are only written
+			 *	once the running function no longer writes them.
+			 */
+			if (as->call->api != api)
+			{
+				job = as->call;
+				async_done.wait(lock, [&job] { return job->done; });
+				lock.unlock();
+				return report(type, handle, "Function sequence error", "HY010");
+			}
+			if (!as->call->done)
+				return SQL_STILL_EXECUTING;
+			job = as->call;
+			as->call.reset();
+		}
+		/* SQL_ASYNC_ENABLE_OFF and SQL_ASYNC_DBC_ENABLE_OFF */
+		else if (as && SQL_ASYNC_ENABLE_OFF != as->enable)
+		{
+			job = std::make_shared<AsyncCall>();
+			job->api = api;
+			job->started = job->done = job->cancelled = FALSE;
+			job->ret = SQL_ERROR;
+			as->call = job;
+		}
+	}
+	if (!job)
+		return call();
+	if (job->done)
+		return finish(type, handle, job);
+
+	if (!submit([handle, as, job, call]() { run(handle, as, job, call); }))
+	{
+		{
+			std::lock_guard<std::mutex>	lock(async_lock);
+
+			as->call.reset();
+		}
+		/* executed as if asynchronous execution were off */
+		return call();
+	}
+	return SQL_STILL_EXECUTING;
+}
+
+void
+AE_cancel(ODBCStatement *stmt)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+	AsyncState	*as = EX_stmt(stmt)->async;
+
+	if (as && as->call && !as->call->done)
+		as->call->cancelled = TRUE;
+}
+
+RETCODE
+AE_complete(SQLSMALLINT type, SQLHANDLE handle, RETCODE *ret)
+{
+	std::shared_ptr<AsyncCall>	job;
+	RETCODE		rc;
+
+	{
+		std::unique_lock<std::mutex>	lock(async_lock);
+		AsyncState	*as = *slot_of(type, handle);
+
+		if (as && as->call)
+		{
+			job = as->call;
+			async_done.wait(lock, [&job] { return job->done; });
+			as->call.reset();
+		}
+	}
+	/* nothing runs on the handle, its diagnostics are free to use */
+	if (!job)
+		return report(type, handle, "Function sequence error", "HY010");
+	rc = finish(type, handle, job);
+	if (ret)
+		*ret = rc;
+	return SQL_SUCCESS;
+}
+
+BOOL
+AE_set_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+	AsyncState	**slot = &EX_stmt(stmt)->async;
+
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_ENABLE:
+			if (SQL_ASYNC_ENABLE_OFF != (SQLULEN) value &&
+			    SQL_ASYNC_ENABLE_ON != (SQLULEN) value)
+				throw DriverException("Invalid attribute value", "HY024");
+			get_state(slot)->enable = (SQLULEN) value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_STMT_EVENT:
+			get_state(slot)->event = value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+			get_state(slot)->callback = (AsyncCallback) value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+			get_state(slot)->context = value;
+			return TRUE;
+	}
+	return FALSE;
+}
+
+BOOL
+AE_get_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+	AsyncState	*as;
+
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_ENABLE:
+		case SQL_ATTR_ASYNC_STMT_EVENT:
+		case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+		case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+			break;
+		default:
+			return FALSE;
+	}
+	as = get_state(&EX_stmt(stmt)->async);
+	if (!value)
+		return TRUE;
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_ENABLE:
+			*((SQLULEN *) value) = as->enable;
+			break;
+		case SQL_ATTR_ASYNC_STMT_EVENT:
+			*((SQLPOINTER *) value) = as->event;
+			break;
+		case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+			*((SQLPOINTER *) value) = (SQLPOINTER) as->callback;
+			break;
+		case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+			*((SQLPOINTER *) value) = as->context;
+			break;
+	}
+	return TRUE;
+}
+
+BOOL
+AE_set_conn_attr(ODBCConnection *conn, SQLINTEGER attr, PTR value)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+	ConnectionExt	*ext = EX_conn(conn);
+	std::vector<ODBCStatement *>	stmts;
+	size_t		i;
+
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_ENABLE:
+			if (SQL_ASYNC_ENABLE_OFF != (SQLULEN) value &&
+			    SQL_ASYNC_ENABLE_ON != (SQLULEN) value)
+				throw DriverException("Invalid attribute value", "HY024");
+			ext->async_enable = (SQLULEN) value;
+			/* it applies to the statements already allocated too */
+			EX_statements(conn, stmts);
+			for (i = 0; i < stmts.size(); i++)
+				get_state(&EX_stmt(stmts[i])->async)->enable = (SQLULEN) value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+			if (SQL_ASYNC_DBC_ENABLE_OFF != (SQLULEN) value &&
+			    SQL_ASYNC_DBC_ENABLE_ON != (SQLULEN) value)
+				throw DriverException("Invalid attribute value", "HY024");
+			get_state(&ext->async)->enable = (SQLULEN) value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_DBC_EVENT:
+			get_state(&ext->async)->event = value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_DBC_PCALLBACK:
+			get_state(&ext->async)->callback = (AsyncCallback) value;
+			return TRUE;
+		case SQL_ATTR_ASYNC_DBC_PCONTEXT:
+			get_state(&ext->async)->context = value;
+			return TRUE;
+	}
+	return FALSE;
+}
+
+BOOL
+AE_get_conn_attr(ODBCConnection *conn, SQLINTEGER attr, PTR value)
+{
+	std::lock_guard<std::mutex>	lock(async_lock);
+	ConnectionExt	*ext = EX_conn(conn);
+	AsyncState	*as;
+
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_ENABLE:
+			if (value)
+				*((SQLULEN *) value) = ext->async_enable;
+			return TRUE;
+		case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+		case SQL_ATTR_ASYNC_DBC_EVENT:
+		case SQL_ATTR_ASYNC_DBC_PCALLBACK:
+		case SQL_ATTR_ASYNC_DBC_PCONTEXT:
+			break;
+		default:
+			return FALSE;
+	}
+	as = get_state(&ext->async);
+	if (!value)
+		return TRUE;
+	switch (attr)
+	{
+		case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+			*((SQLULEN *) value) = as->enable;
+			break;
+		case SQL_ATTR_ASYNC_DBC_EVENT:
+			*((SQLPOINTER *) value) = as->event;
+			break;
+		case SQL_ATTR_ASYNC_DBC_PCALLBACK:
+			*((SQLPOINTER *) value) = (SQLPOINTER) as->callback;
+			break;
+		case SQL_ATTR_ASYNC_DBC_PCONTEXT:
+			*((SQLPOINTER *) value) = as->context;
+			break;
+	}
+	return TRUE;
+}
+
+BOOL
+AE_get_info(SQLUSMALLINT type, PTR value, SQLSMALLINT *len)
+{
+	SQLUINTEGER	ival;
+
+	switch (type)
+	{
+		case SQL_ASYNC_MODE:
+			ival = SQL_AM_STATEMENT;
+			break;
+		case SQL_ASYNC_DBC_FUNCTIONS:
+			ival = SQL_ASYNC_DBC_CAPABLE;
+			break;
+		case SQL_ASYNC_NOTIFICATION:
+			ival = SQL_ASYNC_NOTIFICATION_CAPABLE;
+			break;
+		case SQL_MAX_ASYNC_CONCURRENT_STATEMENTS:
+			ival = 0;	/* no limit */
+			break;
+		default:
+			return FALSE;
+	}
+	if (value)
+		*((SQLUINTEGER *) value) = ival;
+	if (len)
+		*len = sizeof(SQLUINTEGER);
+	return TRUE;
+}
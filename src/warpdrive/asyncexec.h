@@ -0,0 +1,82 @@
+/* File:			asyncexec.h
+ *
+ * Description:		See "asyncexec.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __ASYNCEXEC_H__
+#define __ASYNCEXEC_H__
+
+#include "wdodbc.h"
+
+#include <functional>
+
+namespace ODBC
+{
+  class ODBCConnection;
+  class ODBCStatement;
+}
+
+/* Most threads the driver runs asynchronous functions on at once */
+#define	AE_MAX_WORKERS	64
+
+/*
+ *	Statements are attached to their connection when allocated, taking
+ *	its SQL_ATTR_ASYNC_ENABLE, and detached when freed, waiting for an
+ *	asynchronous function still running on them.  AE_drop() does the same
+ *	for a connection when it is freed.
+ */
+void	AE_attach(ODBC::ODBCConnection *conn, ODBC::ODBCStatement *stmt);
+void	AE_detach(ODBC::ODBCStatement *stmt);
+void	AE_drop(ODBC::ODBCConnection *conn);
+
+/*
+ *	Call 'call', the ExecuteWithDiagnostics() of function 'api' (an
+ *	SQL_API_ value) on 'handle', a statement or connection handle as
+ *	'type' says.  With SQL_ATTR_ASYNC_ENABLE (for connections
+ *	SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE) on, the first call is queued to
+ *	the driver's threads and SQL_STILL_EXECUTING is returned, as it is on
+ *	later calls of 'api' until it is done; the call after that returns
+ *	what 'call' returned.  'call' must then copy what it uses rather than
+ *	refer to the caller's locals; the application's buffers it may keep
+ *	pointers to, as they stay valid until the function is done.  Another
+ *	function called on 'handle' meanwhile fails with HY010 once the
+ *	running one is done.
+ */
+RETCODE	AE_run(SQLSMALLINT type, SQLHANDLE handle, SQLUSMALLINT api,
+		std::function<RETCODE()> call);
+
+/* SQLCancel: the asynchronous function of 'stmt', if any, ends with HY008 */
+void	AE_cancel(ODBC::ODBCStatement *stmt);
+
+/*
+ *	SQLCompleteAsync: wait for the asynchronous function of 'handle' to be
+ *	done and set '*ret' to what it returned.  Like AE_run() it is not
+ *	called through ExecuteWithDiagnostics(), which would clear what the
+ *	function left in the diagnostics.
+ */
+RETCODE	AE_complete(SQLSMALLINT type, SQLHANDLE handle, RETCODE *ret);
+
+/*
+ *	SQLSetStmtAttr and SQLGetStmtAttr of SQL_ATTR_ASYNC_ENABLE,
+ *	SQL_ATTR_ASYNC_STMT_EVENT and the notification callback attributes the
+ *	driver manager sets; for connections, SQL_ATTR_ASYNC_ENABLE and the
+ *	SQL_ATTR_ASYNC_DBC_ ones.
+ *	Return FALSE, doing nothing, for any other attribute.  Throw
+ *	DriverException.
+ */
+BOOL	AE_set_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+BOOL	AE_get_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+BOOL	AE_set_conn_attr(ODBC::ODBCConnection *conn, SQLINTEGER attr, PTR value);
+BOOL	AE_get_conn_attr(ODBC::ODBCConnection *conn, SQLINTEGER attr, PTR value);
+
+/*
+ *	SQLGetInfo of SQL_ASYNC_MODE, SQL_ASYNC_DBC_FUNCTIONS,
+ *	SQL_ASYNC_NOTIFICATION and SQL_MAX_ASYNC_CONCURRENT_STATEMENTS.
+ *	Returns FALSE for other types.
+ */
+BOOL	AE_get_info(SQLUSMALLINT type, PTR value, SQLSMALLINT *len);
+
+#endif /* __ASYNCEXEC_H__ */
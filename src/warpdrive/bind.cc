@@ -27,6 +27,7 @@
 #include "qresult.h"
 #include "wdtypes.h"
 #include "multibyte.h"
+#include "paramset.h"
 
 #include "wdapifunc.h"
 #include <odbcabstraction/odbc_impl/ODBCDescriptor.h>
@@ -48,102 +49,14 @@ WD_BindParameter(HSTMT hstmt,
 					SQLLEN cbValueMax,
 					SQLLEN * pcbValue)
 {
-	StatementClass *stmt = (StatementClass *) hstmt;
 	CSTR func = "WD_BindParameter";
-	APDFields	*apdopts;
-	IPDFields	*ipdopts;
-	PutDataInfo	*pdata_info;
-
-	MYLOG(0, "entering...\n");
-
-	if (!stmt)
-	{
-		SC_log_error(func, "", NULL);
-		return SQL_INVALID_HANDLE;
-	}
-	SC_clear_error(stmt);
-
-	apdopts = SC_get_APDF(stmt);
-	if (apdopts->allocated < ipar)
-		extend_parameter_bindings(apdopts, ipar);
-	ipdopts = SC_get_IPDF(stmt);
-	if (ipdopts->allocated < ipar)
-		extend_iparameter_bindings(ipdopts, ipar);
-	pdata_info = SC_get_PDTI(stmt);
-	if (pdata_info->allocated < ipar)
-		extend_putdata_info(pdata_info, ipar, FALSE);
-
-	/* use zero based column numbers for the below part */
-	ipar--;
-
-	/* store the given info */
-	apdopts->parameters[ipar].buflen = cbValueMax;
-	apdopts->parameters[ipar].buffer = static_cast<char*>(rgbValue);
-	apdopts->parameters[ipar].used =
-	apdopts->parameters[ipar].indicator = pcbValue;
-	apdopts->parameters[ipar].CType = fCType;
-	ipdopts->parameters[ipar].SQLType = fSqlType;
-	ipdopts->parameters[ipar].paramType = fParamType;
-	ipdopts->parameters[ipar].column_size = cbColDef;
-	ipdopts->parameters[ipar].decimal_digits = ibScale;
-	ipdopts->parameters[ipar].precision = 0;
-	ipdopts->parameters[ipar].scale = 0;
-	switch (fCType)
-	{
-		case SQL_C_NUMERIC:
-			if (cbColDef > 0)
-				ipdopts->parameters[ipar].precision = (UInt2) cbColDef;
-			if (ibScale > 0)
-				ipdopts->parameters[ipar].scale = ibScale;
-			break;
-		case SQL_C_TYPE_TIMESTAMP:
-			if (ibScale > 0)
-				ipdopts->parameters[ipar].precision = ibScale;
-			break;
-		case SQL_C_INTERVAL_DAY_TO_SECOND:
-		case SQL_C_INTERVAL_HOUR_TO_SECOND:
-		case SQL_C_INTERVAL_MINUTE_TO_SECOND:
-		case SQL_C_INTERVAL_SECOND:
-				ipdopts->parameters[ipar].precision = 6;
-			break;
-	}
-	apdopts->parameters[ipar].precision = ipdopts->parameters[ipar].precision;
-	apdopts->parameters[ipar].scale = ipdopts->parameters[ipar].scale;
-
-	/*
-	 * If rebinding a parameter that had data-at-exec stuff in it, then
-	 * free that stuff
-	 */
-	if (pdata_info->pdata[ipar].EXEC_used)
-	{
-		free(pdata_info->pdata[ipar].EXEC_used);
-		pdata_info->pdata[ipar].EXEC_used = NULL;
-	}
-
-	if (pdata_info->pdata[ipar].EXEC_buffer)
-	{
-		free(pdata_info->pdata[ipar].EXEC_buffer);
-		pdata_info->pdata[ipar].EXEC_buffer = NULL;
-	}
-
-	if (pcbValue && apdopts->param_offset_ptr)
-		pcbValue = LENADDR_SHIFT(pcbValue, *apdopts->param_offset_ptr);
-#ifdef	NOT_USED /* evaluation of pcbValue here is dangerous */
-	/* Data at exec macro only valid for C char/binary data */
-	if (pcbValue && (*pcbValue == SQL_DATA_AT_EXEC ||
-					 *pcbValue <= SQL_LEN_DATA_AT_EXEC_OFFSET))
-		apdopts->parameters[ipar].data_at_exec = TRUE;
-	else
-		apdopts->parameters[ipar].data_at_exec = FALSE;
-#endif /* NOT_USED */
-
-	/* Clear premature result */
-	if (stmt->status == STMT_DESCRIBED)
-		SC_recycle_statement(stmt);
+	ODBCStatement *stmt = reinterpret_cast<ODBCStatement*>(hstmt);
 
 	MYLOG(0, "ipar=%d, paramType=%d, fCType=%d, fSqlType=%d, cbColDef=" FORMAT_ULEN ", ibScale=%d,", ipar, fParamType, fCType, fSqlType, cbColDef, ibScale);
 	MYPRINTF(0, "rgbValue=%p(" FORMAT_LEN "), pcbValue=%p\n", rgbValue, cbValueMax, pcbValue);
 
+	PS_bind(PS_get(stmt, TRUE), ipar, fParamType, fCType, fSqlType, cbColDef,
+			ibScale, rgbValue, cbValueMax, pcbValue);
 	return SQL_SUCCESS;
 }
 
@@ -166,12 +79,8 @@ WD_BindCol(HSTMT hstmt,
 
 
 /*
- *	Returns the description of a parameter marker.
- *	This function is listed as not being supported by SQLGetFunctions() because it is
- *	used to describe "parameter markers" (not bound parameters), in which case,
- *	the dbms should return info on the markers.  Since Postgres doesn't support that,
- *	it is best to say this function is not supported and let the application assume a
- *	data type (most likely varchar).
+ *	Returns the description of a parameter marker, from the binding of the
+ *	parameter.
  */
 RETCODE		SQL_API
 WD_DescribeParam(HSTMT hstmt,
@@ -181,136 +90,36 @@ WD_DescribeParam(HSTMT hstmt,
 					SQLSMALLINT * pibScale,
 					SQLSMALLINT * pfNullable)
 {
-	StatementClass *stmt = (StatementClass *) hstmt;
 	CSTR func = "WD_DescribeParam";
-	IPDFields	*ipdopts;
-	RETCODE		ret = SQL_SUCCESS;
-	int		num_params;
-	OID		wdtype;
-	ConnectionClass	*conn;
+	ODBCStatement *stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+	ParamSet	*ps = PS_get(stmt, FALSE);
 
 	MYLOG(0, "entering...%d\n", ipar);
 
-	if (!stmt)
-	{
-		SC_log_error(func, "", NULL);
-		return SQL_INVALID_HANDLE;
-	}
-	conn = SC_get_conn(stmt);
-	SC_clear_error(stmt);
-
-	ipdopts = SC_get_IPDF(stmt);
-	/*if ((ipar < 1) || (ipar > ipdopts->allocated))*/
-	num_params = stmt->num_params;
-	if (num_params < 0)
-	{
-		SQLSMALLINT	num_p;
-
-		WD_NumParams(stmt, &num_p);
-		num_params = num_p;
-	}
-	if ((ipar < 1) || (ipar > num_params))
-	{
-MYLOG(DETAIL_LOG_LEVEL, "num_params=%d\n", stmt->num_params);
-		SC_set_error(stmt, STMT_BAD_PARAMETER_NUMBER_ERROR, "Invalid parameter number for WD_DescribeParam.", func);
-		return SQL_ERROR;
-	}
-	extend_iparameter_bindings(ipdopts, stmt->num_params);
-
-#define	return	DONT_CALL_RETURN_FROM_HERE???
-	/* StartRollbackState(stmt); */
-	if (NOT_YET_PREPARED == stmt->prepared)
-	{
-		decideHowToPrepare(stmt, FALSE);
-MYLOG(DETAIL_LOG_LEVEL, "howTo=%d\n", SC_get_prepare_method(stmt));
-		switch (SC_get_prepare_method(stmt))
-		{
-			case NAMED_PARSE_REQUEST:
-			case PARSE_TO_EXEC_ONCE:
-			case PARSE_REQ_FOR_INFO:
-				if (ret = prepareParameters(stmt, FALSE), SQL_ERROR == ret)
-					goto cleanup;
-		}
-	}
-
-	ipar--;
-	wdtype = PIC_get_wdtype(ipdopts->parameters[ipar]);
-	/*
-	 * This implementation is not very good, since it is supposed to
-	 * describe
-	 */
-	/* parameter markers, not bound parameters.  */
-	if (pfSqlType)
-	{
-MYLOG(DETAIL_LOG_LEVEL, "[%d].SQLType=%d .wdtype=%d\n", ipar, ipdopts->parameters[ipar].SQLType, wdtype);
-		if (ipdopts->parameters[ipar].SQLType)
-			*pfSqlType = ipdopts->parameters[ipar].SQLType;
-		else if (wdtype)
-			*pfSqlType = wdtype_attr_to_concise_type(conn, wdtype, WD_ATP_UNSET, WD_ADT_UNSET, WD_UNKNOWNS_UNSET);
-		else
-		{
-			ret = SQL_ERROR;
-			SC_set_error(stmt, STMT_EXEC_ERROR, "Unfortunatley couldn't get this paramater's info", func);
-			goto cleanup;
-		}
-	}
-
-	if (pcbParamDef)
-	{
-		*pcbParamDef = 0;
-		if (ipdopts->parameters[ipar].SQLType)
-			*pcbParamDef = ipdopts->parameters[ipar].column_size;
-		if (0 == *pcbParamDef && wdtype)
-			*pcbParamDef = wdtype_attr_column_size(conn, wdtype, WD_ATP_UNSET, WD_ADT_UNSET, WD_UNKNOWNS_UNSET);
-	}
-
-	if (pibScale)
-	{
-		*pibScale = 0;
-		if (ipdopts->parameters[ipar].SQLType)
-			*pibScale = ipdopts->parameters[ipar].decimal_digits;
-		else if (wdtype)
-			*pibScale = wdtype_scale(stmt, wdtype, -1);
-	}
-
-	if (pfNullable)
-		*pfNullable = wdtype_nullable(SC_get_conn(stmt), ipdopts->parameters[ipar].paramType);
-cleanup:
-#undef	return
-	return ret;
+	if (!ps)
+		throw driver::odbcabstraction::DriverException("Invalid descriptor index", "07009");
+	PS_describe(stmt, ps, ipar, pfSqlType, pcbParamDef, pibScale, pfNullable);
+	return SQL_SUCCESS;
 }
 
 
 /*
- *	This function should really talk to the dbms to determine the number of
- *	"parameter markers" (not bound parameters) in the statement.  But, since
- *	Postgres doesn't support that, the driver should just count the number of markers
- *	and return that.  The reason the driver just can't say this function is unsupported
- *	like it does for SQLDescribeParam is that some applications don't care and try
- *	to call it anyway.
- *	If the statement does not have parameters, it should just return 0.
+ *	The number of parameter markers counted in the statement text.  A
+ *	statement without parameters returns 0.
  */
 RETCODE		SQL_API
 WD_NumParams(HSTMT hstmt,
 				SQLSMALLINT * pcpar)
 {
-	StatementClass *stmt = (StatementClass *) hstmt;
 	CSTR func = "WD_NumParams";
+	ODBCStatement *stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+	ParamSet	*ps = PS_get(stmt, FALSE);
 
 	MYLOG(0, "entering...\n");
 
-	if (!stmt)
-	{
-		SC_log_error(func, "", NULL);
-		return SQL_INVALID_HANDLE;
-	}
-
-	if (pcpar) {
-		*pcpar = 0;
-    } else {
-        throw driver::odbcabstraction::DriverException("Parameter count address is null");
-	}
-
+	if (!pcpar)
+		throw driver::odbcabstraction::DriverException("Parameter count address is null");
+	*pcpar = ps ? PS_num_params(stmt, ps) : 0;
 	return SQL_SUCCESS;
 }
 
@@ -0,0 +1,285 @@
+/*-------
+ * Module:			bulkops.cc
+ *
+ * Description:		This module contains SQLBulkOperations(SQL_ADD).
+ *
+ *					The rowset bound to the columns of a result set is
+ *					inserted into the table they come from.  The bound
+ *					columns of the ARD become the parameters of an INSERT
+ *					of those columns, on another statement of the
+ *					connection so that the result set stays open, and the
+ *					rows of the rowset its parameter sets: the rowset is
+ *					converted column by column into one batch and sent in
+ *					one execution, as SQLExecute does for parameter arrays.
+ *
+ *					The row operation array (SQL_ATTR_ROW_OPERATION_PTR)
+ *					leaves rows out, and the row status array
+ *					(SQL_ATTR_ROW_STATUS_PTR) says which ones were added
+ *					and which were ignored.
+ *
+ * Classes:			none
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "bulkops.h"
+#include "extension.h"
+#include "paramset.h"
+#include "transact.h"
+#include "mylog.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/odbc_impl/ODBCDescriptor.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::DescriptorRecord;
+using ODBC::ODBCConnection;
+using ODBC::ODBCDescriptor;
+using ODBC::ODBCStatement;
+
+static const std::string &
+table_of(const DescriptorRecord &record)
+{
+	return record.m_baseTableName.empty() ? record.m_tableName : record.m_baseTableName;
+}
+
+static const std::string &
+column_of(const DescriptorRecord &record)
+{
+	return record.m_baseColumnName.empty() ? record.m_name : record.m_baseColumnName;
+}
+
+static void
+append_identifier(std::string &out, const std::string &name)
+{
+	size_t	i;
+
+	out += IDENTIFIER_QUOTE;
+	for (i = 0; i < name.size(); i++)
+	{
+		if (IDENTIFIER_QUOTE == name[i])
+			out += IDENTIFIER_QUOTE;
+		out += name[i];
+	}
+	out += IDENTIFIER_QUOTE;
+}
+
+/* The INSERT of the result set columns 'columns' (0 based) into their table */
+static std::string
+insert_text(const std::vector<DescriptorRecord> &records, const std::vector<SQLUSMALLINT> &columns)
+{
+	const DescriptorRecord	&first = records[columns[0]];
+	std::string	sql("INSERT INTO ");
+	size_t		i;
+
+	if (table_of(first).empty())
+		throw DriverException("The table of the result set is not known", "HY000");
+	for (i = 1; i < columns.size(); i++)
+	{
+		const DescriptorRecord	&record = records[columns[i]];
+
+		if (table_of(record) != table_of(first) ||
+		    record.m_schemaName != first.m_schemaName ||
+		    record.m_catalogName != first.m_catalogName)
+			throw DriverException("The bound columns do not come from one table", "HY000");
+	}
+	if (!first.m_catalogName.empty())
+	{
+		append_identifier(sql, first.m_catalogName);
+		sql += '.';
+	}
+	if (!first.m_schemaName.empty())
+	{
+		append_identifier(sql, first.m_schemaName);
+		sql += '.';
+	}
+	append_identifier(sql, table_of(first));
+	sql += " (";
+	for (i = 0; i < columns.size(); i++)
+	{
+		if (i > 0)
+			sql += ", ";
+		append_identifier(sql, column_of(records[columns[i]]));
+	}
+	sql += ") VALUES (";
+	for (i = 0; i < columns.size(); i++)
+		sql += i > 0 ? ", ?" : "?";
+	sql += ')';
+	return sql;
+}
+
+static SQLULEN
+column_size(const DescriptorRecord &record)
+{
+	switch (record.m_conciseType)
+	{
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+			return record.m_precision;
+	}
+	return record.m_length;
+}
+
+/* Bind bound column 'icol' of 'ard' as parameter 'ipar' of 'ps' */
+static void
+bind_column(ParamSet *ps, SQLUSMALLINT ipar, ODBCDescriptor *ard, SQLUSMALLINT icol,
+	    const DescriptorRecord &record)
+{
+	SQLSMALLINT	ctype = SQL_C_DEFAULT;
+	PTR		data = NULL;
+	SQLLEN		buflen = 0;
+	SQLLEN		*indicator = NULL;
+
+	ard->GetField(icol, SQL_DESC_CONCISE_TYPE, &ctype, 0, NULL);
+	ard->GetField(icol, SQL_DESC_DATA_PTR, &data, 0, NULL);
+	ard->GetField(icol, SQL_DESC_OCTET_LENGTH, &buflen, 0, NULL);
+	ard->GetField(icol, SQL_DESC_INDICATOR_PTR, &indicator, 0, NULL);
+	if (!indicator)
+		ard->GetField(icol, SQL_DESC_OCTET_LENGTH_PTR, &indicator, 0, NULL);
+	PS_bind(ps, ipar, SQL_PARAM_INPUT, ctype, record.m_conciseType,
+		column_size(record), record.m_scale, data, buflen, indicator);
+}
+
+/* Insert on 'helper' and fill 'status' with the status of each parameter set */
+static void
+insert_rowset(ODBCStatement *stmt, ODBCStatement *helper, const std::string &sql,
+	      const std::vector<SQLUSMALLINT> &columns, std::vector<SQLUSMALLINT> &status)
+{
+	ODBCDescriptor	*ard = stmt->GetARD();
+	const std::vector<DescriptorRecord>	&records = stmt->GetIRD()->GetRecords();
+	ParamSet	*ps = PS_get(helper, TRUE);
+	SQLULEN		timeout = 0;
+	SQLINTEGER	bind_type = SQL_BIND_BY_COLUMN;
+	SQLLEN		*bind_offset = NULL;
+	SQLUSMALLINT	*operations = NULL;
+	size_t		i;
+	RETCODE		ret;
+
+	for (i = 0; i < columns.size(); i++)
+		bind_column(ps, (SQLUSMALLINT) (i + 1), ard, columns[i] + 1, records[columns[i]]);
+	ard->GetHeaderField(SQL_DESC_BIND_TYPE, &bind_type, 0, NULL);
+	ard->GetHeaderField(SQL_DESC_BIND_OFFSET_PTR, &bind_offset, 0, NULL);
+	ard->GetHeaderField(SQL_DESC_ARRAY_STATUS_PTR, &operations, 0, NULL);
+	PS_set_attr(helper, SQL_ATTR_PARAMSET_SIZE, (PTR) (SQLULEN) status.size());
+	PS_set_attr(helper, SQL_ATTR_PARAM_BIND_TYPE, (PTR) (SQLULEN) bind_type);
+	PS_set_attr(helper, SQL_ATTR_PARAM_BIND_OFFSET_PTR, bind_offset);
+	PS_set_attr(helper, SQL_ATTR_PARAM_OPERATION_PTR, operations);
+	PS_set_attr(helper, SQL_ATTR_PARAM_STATUS_PTR, &status[0]);
+	stmt->GetStmtAttr(SQL_ATTR_QUERY_TIMEOUT, &timeout, 0, NULL, false);
+	helper->SetStmtAttr(SQL_ATTR_QUERY_TIMEOUT, (PTR) timeout, 0, false);
+
+	helper->Prepare(sql);
+	PS_set_query(ps, sql.data(), sql.size());
+	TX_work(&helper->GetConnection());
+	PS_execute(helper, ps, &ret);
+	if (SQL_NEED_DATA == ret)
+		throw DriverException("Data at execution is not supported by SQLBulkOperations", "HYC00");
+}
+
+RETCODE
+BO_add(ODBCStatement *stmt)
+{
+	ODBCDescriptor	*ard = stmt->GetARD();
+	const std::vector<DescriptorRecord>	&records = stmt->GetIRD()->GetRecords();
+	SQLSMALLINT	count = 0;
+	SQLULEN		nrows = 1, row;
+	SQLUSMALLINT	*row_status = NULL;
+	std::vector<SQLUSMALLINT>	columns;
+	SQLUSMALLINT	icol;
+	int		errors = 0, warnings = 0;
+
+	if (records.empty())
+		throw DriverException("Function sequence error", "HY010");
+	ard->GetHeaderField(SQL_DESC_COUNT, &count, 0, NULL);
+	ard->GetHeaderField(SQL_DESC_ARRAY_SIZE, &nrows, 0, NULL);
+	stmt->GetIRD()->GetHeaderField(SQL_DESC_ARRAY_STATUS_PTR, &row_status, 0, NULL);
+	for (icol = 1; icol <= count && icol <= records.size(); icol++)
+	{
+		PTR	data = NULL;
+
+		ard->GetField(icol, SQL_DESC_DATA_PTR, &data, 0, NULL);
+		if (data)
+			columns.push_back(icol - 1);
+	}
+	if (columns.empty())
+		throw DriverException("COUNT field incorrect", "07002");
+	if (0 == nrows)
+		nrows = 1;
+
+	std::string	sql = insert_text(records, columns);
+	ODBCConnection	&conn = stmt->GetConnection();
+	std::shared_ptr<ODBCStatement>	helper = conn.createStatement();
+	std::vector<SQLUSMALLINT>	status(nrows, SQL_PARAM_UNUSED);
+
+	MYLOG(0, "adding " FORMAT_ULEN " rows: %s\n", nrows, sql.c_str());
+	try
+	{
+		insert_rowset(stmt, helper.get(), sql, columns, status);
+	}
+	catch (...)
+	{
+		PS_drop(helper.get());
+		EX_forget_stmt(helper.get());
+		helper->releaseStatement();
+		throw;
+	}
+	PS_drop(helper.get());
+	EX_forget_stmt(helper.get());
+	helper->releaseStatement();
+
+	for (row = 0; row < nrows; row++)
+	{
+		switch (status[row])
+		{
+			case SQL_PARAM_SUCCESS:
+				if (row_status)
+					row_status[row] = SQL_ROW_ADDED;
+				break;
+			case SQL_PARAM_SUCCESS_WITH_INFO:
+				warnings++;
+				if (row_status)
+					row_status[row] = SQL_ROW_SUCCESS_WITH_INFO;
+				break;
+			case SQL_PARAM_ERROR:
+				errors++;
+				if (row_status)
+					row_status[row] = SQL_ROW_ERROR;
+				break;
+			case SQL_PARAM_UNUSED:
+				/* left out by the row operation array */
+				if (row_status)
+					row_status[row] = SQL_ROW_IGNORE;
+				break;
+		}
+	}
+	if (errors > 0)
+		stmt->GetDiagnostics().AddWarning("Error in row", "01S01", 0);
+	else if (warnings > 0)
+		stmt->GetDiagnostics().AddWarning("Rows were added with warnings", "01000", 0);
+	else
+		return SQL_SUCCESS;
+	return SQL_SUCCESS_WITH_INFO;
+}
+
+void
+BO_adjust_info(SQLUSMALLINT type, PTR value)
+{
+	switch (type)
+	{
+		case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1:
+		case SQL_STATIC_CURSOR_ATTRIBUTES1:
+			if (value)
+				*((SQLUINTEGER *) value) |= SQL_CA1_BULK_ADD;
+			break;
+	}
+}
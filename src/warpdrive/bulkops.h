@@ -0,0 +1,32 @@
+/* File:			bulkops.h
+ *
+ * Description:		See "bulkops.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __BULKOPS_H__
+#define __BULKOPS_H__
+
+#include "wdodbc.h"
+
+namespace ODBC
+{
+  class ODBCStatement;
+}
+
+/*
+ *	SQLBulkOperations(SQL_ADD): insert the rowset bound to the columns of
+ *	the result set of 'stmt' into the table they come from, filling the
+ *	row status array.  Throws DriverException.
+ */
+RETCODE	BO_add(ODBC::ODBCStatement *stmt);
+
+/*
+ *	After the connection answered SQLGetInfo of 'type' into 'value': add
+ *	SQL_CA1_BULK_ADD to the cursor attributes.
+ */
+void	BO_adjust_info(SQLUSMALLINT type, PTR value);
+
+#endif /* __BULKOPS_H__ */
@@ -0,0 +1,94 @@
+/*-------
+ * Module:			colconv.cc
+ *
+ * Description:		This module contains the handling of conversion results
+ *					shared by the parameter conversions.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "colconv.h"
+
+#include <odbcabstraction/diagnostics.h>
+#include <odbcabstraction/encoding.h>
+#include <odbcabstraction/exceptions.h>
+
+using driver::odbcabstraction::Diagnostics;
+using driver::odbcabstraction::DriverException;
+
+static int
+result_rank(int result)
+{
+	switch (result)
+	{
+		case COPY_OK:
+		case COPY_NO_DATA_FOUND:
+			return 0;
+		case COPY_RESULT_TRUNCATED:
+		case COPY_FRACTION_TRUNCATED:
+			return 1;
+	}
+	return 2;
+}
+
+int
+CC_worse_result(int current, int row_result)
+{
+	return result_rank(row_result) > result_rank(current) ? row_result : current;
+}
+
+SQLUSMALLINT
+CC_row_status(int row_result)
+{
+	switch (result_rank(row_result))
+	{
+		case 0:
+			return SQL_ROW_SUCCESS;
+		case 1:
+			return SQL_ROW_SUCCESS_WITH_INFO;
+	}
+	return SQL_ROW_ERROR;
+}
+
+void
+CC_report_result(int result, Diagnostics &diagnostics)
+{
+	switch (result)
+	{
+		case COPY_OK:
+		case COPY_NO_DATA_FOUND:
+			return;
+		case COPY_RESULT_TRUNCATED:
+			diagnostics.AddTruncationWarning();
+			return;
+		case COPY_FRACTION_TRUNCATED:
+			diagnostics.AddWarning("Fractional truncation", "01S07", 0);
+			return;
+		case COPY_NUMERIC_OUT_OF_RANGE:
+			throw DriverException("Numeric value out of range", "22003");
+		case COPY_INVALID_STRING_CONVERSION:
+			throw DriverException("Invalid character value for cast specification", "22018");
+		case COPY_INVALID_DATETIME_FORMAT:
+			throw DriverException("Invalid datetime format", "22007");
+		case COPY_DATETIME_OVERFLOW:
+			throw DriverException("Datetime field overflow", "22008");
+		case COPY_UNSUPPORTED_CONVERSION:
+		case COPY_UNSUPPORTED_TYPE:
+			throw DriverException("Restricted data type attribute violation", "07006");
+	}
+	throw DriverException("General error");
+}
+
+size_t
+CC_sqlwchar_size(void)
+{
+	static const size_t wclen = driver::odbcabstraction::GetSqlWCharSize();
+
+	return wclen;
+}
@@ -0,0 +1,41 @@
+/* File:			colconv.h
+ *
+ * Description:		Results of the conversion of parameter values, shared by
+ *					the conversion modules.
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __COLCONV_H__
+#define __COLCONV_H__
+
+#include "wdodbc.h"
+#include "convert.h"
+
+#include <stddef.h>
+
+/*
+ * Conversion results not covered by the copy_and_convert codes in convert.h.
+ * A row of parameters gets the worst result of its values, see CC_worse_result().
+ */
+#define COPY_NUMERIC_OUT_OF_RANGE				7	/* 22003 */
+#define COPY_INVALID_DATETIME_FORMAT				8	/* 22007 */
+#define COPY_DATETIME_OVERFLOW					9	/* 22008 */
+#define COPY_FRACTION_TRUNCATED					10	/* 01S07 */
+
+/* Merge a value result into the row result, keeping the most severe one. */
+int	CC_worse_result(int current, int row_result);
+/* Translate a row result into SQL_ROW_* */
+SQLUSMALLINT	CC_row_status(int row_result);
+/*
+ *	Report a result on the statement diagnostics: truncations become
+ *	warnings, everything else throws the matching DriverException.
+ */
+namespace driver { namespace odbcabstraction { class Diagnostics; } }
+void	CC_report_result(int result, driver::odbcabstraction::Diagnostics &diagnostics);
+
+/* Size in bytes of one SQLWCHAR as seen by the driver manager */
+size_t	CC_sqlwchar_size(void);
+
+#endif /* __COLCONV_H__ */
@@ -45,6 +45,10 @@
 #include "multibyte.h"
 
 #include "wdapifunc.h"
+#include "asyncexec.h"
+#include "conntime.h"
+#include "transact.h"
+#include "extension.h"
 
 #include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
 #include <odbcabstraction/odbc_impl/ODBCConnection.h>
@@ -198,10 +202,8 @@ WD_Connect(HDBC hdbc,
       connStr += "}";
     }
   }
-  Connection::ConnPropertyMap properties;
-  std::vector<std::string> missing_properties;
-  std::string dsn = ODBCConnection::getPropertiesFromConnString(connStr, properties);
-  conn->connect(dsn, properties, missing_properties);
+  CT_connect(conn, connStr);
+  TX_connected(conn);
   return ret;
 }
 
@@ -237,7 +239,9 @@ WD_Disconnect(HDBC hdbc)
 		return SQL_INVALID_HANDLE;
 	}
 
-	reinterpret_cast<ODBCConnection*>(hdbc)->disconnect();
+	TX_disconnect(reinterpret_cast<ODBCConnection*>(hdbc));
+	SC_forget_statements(reinterpret_cast<ODBCConnection*>(hdbc));
+	CT_disconnect(reinterpret_cast<ODBCConnection*>(hdbc));
 
 	MYLOG(0, "leaving...\n");
 
@@ -259,6 +263,11 @@ WD_FreeConnect(HDBC hdbc)
 	ODBCConnection* conn = ODBCConnection::of(hdbc);
 	try {
 		conn->GetDiagnostics().Clear();
+		SC_forget_statements(conn);
+		AE_drop(conn);
+		CT_drop(conn);
+		TX_drop(conn);
+		EX_forget_conn(conn);
 		conn->releaseConnection();
 		return SQL_SUCCESS;
 	}
@@ -0,0 +1,159 @@
+/*-------
+ * Module:			conntime.cc
+ *
+ * Description:		This module contains the connection and disconnection
+ *					of connections, and how long they took.
+ *
+ *					The time of a connection runs from reading the
+ *					connection string to the connection being open; it is
+ *					logged and kept, in microseconds, for SQLGetConnectAttr.
+ *					The name resolution, channel set up, TLS handshake and
+ *					authentication all happen inside the one connect call
+ *					of the driver, so they cannot be told apart here.
+ *
+ * Classes:			ConnectTimes
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "conntime.h"
+#include "extension.h"
+#include "mylog.h"
+#include "wdapifunc.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+#include <odbcabstraction/spi/connection.h>
+
+using driver::odbcabstraction::Connection;
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCConnection;
+
+typedef std::chrono::steady_clock	Clock;
+
+struct ConnectTimes_
+{
+	SQLULEN		connect;	/* microseconds */
+	SQLULEN		disconnect;
+};
+
+static SQLULEN
+usec_since(Clock::time_point start)
+{
+	return (SQLULEN) std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+/* The times of 'ext', made when there are none.  Under its lock. */
+static ConnectTimes *
+times_of(ConnectionExt *ext)
+{
+	if (!ext->times)
+	{
+		ext->times = new ConnectTimes;
+		ext->times->connect = ext->times->disconnect = 0;
+	}
+	return ext->times;
+}
+
+static void
+record_connect(ODBCConnection *conn, SQLULEN elapsed, BOOL connected)
+{
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	MYLOG(0, "%p: %s in " FORMAT_ULEN " us\n", conn, connected ? "connected" : "failed", elapsed);
+	times_of(ext)->connect = elapsed;
+}
+
+void
+CT_connect(ODBCConnection *conn, const std::string &conn_str)
+{
+	Connection::ConnPropertyMap	properties;
+	std::vector<std::string>	missing_properties;
+	Clock::time_point	start = Clock::now();
+	std::string	dsn;
+
+	dsn = ODBCConnection::getPropertiesFromConnString(conn_str, properties);
+	try
+	{
+		conn->connect(dsn, properties, missing_properties);
+	}
+	catch (const DriverException &)
+	{
+		record_connect(conn, usec_since(start), FALSE);
+		throw;
+	}
+	record_connect(conn, usec_since(start), TRUE);
+}
+
+void
+CT_disconnect(ODBCConnection *conn)
+{
+	Clock::time_point	start = Clock::now();
+	SQLULEN		elapsed;
+
+	conn->disconnect();
+	elapsed = usec_since(start);
+	MYLOG(0, "%p: disconnected in " FORMAT_ULEN " us\n", conn, elapsed);
+
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	times_of(ext)->disconnect = elapsed;
+}
+
+void
+CT_drop(ODBCConnection *conn)
+{
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	delete ext->times;
+	ext->times = NULL;
+}
+
+BOOL
+CT_set_attr(SQLINTEGER attr)
+{
+	switch (attr)
+	{
+		case SQL_ATTR_WD_CONNECT_TIME:
+		case SQL_ATTR_WD_DISCONNECT_TIME:
+			throw DriverException("Invalid attribute/option identifier", "HY092");
+	}
+	return FALSE;
+}
+
+BOOL
+CT_get_attr(ODBCConnection *conn, SQLINTEGER attr, PTR value)
+{
+	ConnectionExt	*ext;
+	ConnectTimes	t = { 0, 0 };
+
+	switch (attr)
+	{
+		case SQL_ATTR_WD_CONNECT_TIME:
+		case SQL_ATTR_WD_DISCONNECT_TIME:
+			break;
+		default:
+			return FALSE;
+	}
+	ext = EX_conn(conn);
+	{
+		std::lock_guard<std::mutex>	lock(ext->lock);
+
+		if (ext->times)
+			t = *ext->times;
+	}
+	if (value)
+		*((SQLULEN *) value) = SQL_ATTR_WD_CONNECT_TIME == attr ? t.connect : t.disconnect;
+	return TRUE;
+}
@@ -0,0 +1,41 @@
+/* File:			conntime.h
+ *
+ * Description:		See "conntime.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __CONNTIME_H__
+#define __CONNTIME_H__
+
+#include "wdodbc.h"
+
+#include <string>
+
+namespace ODBC
+{
+  class ODBCConnection;
+}
+
+/*
+ *	SQLConnect and SQLDriverConnect: connect 'conn' with the attributes of
+ *	the connection string 'conn_str', timed as a whole; its phases are not
+ *	timed apart.  Throws DriverException.
+ */
+void	CT_connect(ODBC::ODBCConnection *conn, const std::string &conn_str);
+/* SQLDisconnect, timed.  Throws DriverException. */
+void	CT_disconnect(ODBC::ODBCConnection *conn);
+/* Forget the times of 'conn' when it is freed */
+void	CT_drop(ODBC::ODBCConnection *conn);
+
+/*
+ *	SQLSetConnectAttr and SQLGetConnectAttr of the read only
+ *	SQL_ATTR_WD_CONNECT_TIME and SQL_ATTR_WD_DISCONNECT_TIME; setting them
+ *	fails with HY092.  Return FALSE, doing nothing, for any other
+ *	attribute.  Throw DriverException.
+ */
+BOOL	CT_set_attr(SQLINTEGER attr);
+BOOL	CT_get_attr(ODBC::ODBCConnection *conn, SQLINTEGER attr, PTR value);
+
+#endif /* __CONNTIME_H__ */
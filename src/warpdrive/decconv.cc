@@ -0,0 +1,327 @@
+/*-------
+ * Module:			decconv.cc
+ *
+ * Description:		This module contains the formatting and parsing of
+ *					Decimal128 and Decimal256 values, used to inline
+ *					parameters into the query text.
+ *
+ *					Values are handled as 256-bit magnitudes held in 32-bit
+ *					limbs, so the arithmetic only needs 64-bit products.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "decconv.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#define	DEC_LIMBS	8
+#define	CHUNK_DIGITS	9
+#define	CHUNK_BASE	1000000000u
+
+typedef struct
+{
+	uint32_t	w[DEC_LIMBS];	/* magnitude, least significant limb first */
+	bool		negative;
+} Int256;
+
+static const uint32_t small_pow10[CHUNK_DIGITS + 1] =
+{
+	1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+	100000000u, 1000000000u
+};
+
+static inline void
+load_bytes(const void *value, int byte_width, Int256 *v)
+{
+	int		nlimbs = byte_width / 4, k;
+	uint32_t	fill;
+
+	/* Arrow decimals are little-endian two's complement */
+	memcpy(v->w, value, byte_width);
+	fill = (v->w[nlimbs - 1] >> 31) ? 0xffffffffu : 0;
+	for (k = nlimbs; k < DEC_LIMBS; k++)
+		v->w[k] = fill;
+	v->negative = 0 != fill;
+	if (v->negative)
+	{
+		uint64_t	carry = 1;
+
+		for (k = 0; k < DEC_LIMBS; k++)
+		{
+			carry += (uint32_t) ~v->w[k];
+			v->w[k] = (uint32_t) carry;
+			carry >>= 32;
+		}
+	}
+}
+
+/* The low 'byte_width' bytes of v in two's complement */
+static void
+store_bytes(const Int256 *v, int byte_width, void *value)
+{
+	uint32_t	w[DEC_LIMBS];
+	uint64_t	carry = 1;
+	int		k;
+
+	for (k = 0; k < DEC_LIMBS; k++)
+	{
+		if (v->negative)
+		{
+			carry += (uint32_t) ~v->w[k];
+			w[k] = (uint32_t) carry;
+			carry >>= 32;
+		}
+		else
+			w[k] = v->w[k];
+	}
+	memcpy(value, w, byte_width);
+}
+
+static inline bool
+is_zero(const Int256 *v)
+{
+	int	k;
+
+	for (k = 0; k < DEC_LIMBS; k++)
+	{
+		if (v->w[k])
+			return false;
+	}
+	return true;
+}
+
+/* v *= m; returns false on overflow */
+static inline bool
+mul_small(Int256 *v, uint32_t m)
+{
+	uint64_t	carry = 0;
+	int		k;
+
+	for (k = 0; k < DEC_LIMBS; k++)
+	{
+		carry += (uint64_t) v->w[k] * m;
+		v->w[k] = (uint32_t) carry;
+		carry >>= 32;
+	}
+	return 0 == carry;
+}
+
+/* v /= d; returns the remainder */
+static inline uint32_t
+div_small(Int256 *v, uint32_t d)
+{
+	uint64_t	rem = 0;
+	int		k;
+
+	for (k = DEC_LIMBS - 1; k >= 0; k--)
+	{
+		rem = (rem << 32) | v->w[k];
+		v->w[k] = (uint32_t) (rem / d);
+		rem %= d;
+	}
+	return (uint32_t) rem;
+}
+
+/* Multiply by 10^n; returns false on overflow */
+static bool
+scale_up(Int256 *v, int n)
+{
+	for (; n > 0; n -= CHUNK_DIGITS)
+	{
+		if (!mul_small(v, small_pow10[n < CHUNK_DIGITS ? n : CHUNK_DIGITS]))
+			return false;
+	}
+	return true;
+}
+
+/* Divide by 10^n, truncating; returns true when non-zero digits were dropped */
+static bool
+scale_down(Int256 *v, int n)
+{
+	bool	dropped = false;
+
+	for (; n > 0 && !is_zero(v); n -= CHUNK_DIGITS)
+	{
+		if (div_small(v, small_pow10[n < CHUNK_DIGITS ? n : CHUNK_DIGITS]))
+			dropped = true;
+	}
+	return dropped;
+}
+
+/*
+ *	Decimal digits of v, least significant first, into 'digits'.  Returns
+ *	the number of digits (1 for zero).
+ */
+static int
+decimal_digits(Int256 v, char *digits)
+{
+	int	n = 0;
+
+	do
+	{
+		uint32_t	chunk = div_small(&v, CHUNK_BASE);
+		bool		last = is_zero(&v);
+		int		k;
+
+		for (k = 0; k < CHUNK_DIGITS && (!last || chunk || 0 == k); k++)
+		{
+			digits[n++] = (char) ('0' + chunk % 10);
+			chunk /= 10;
+		}
+	} while (!is_zero(&v));
+	return n;
+}
+
+static int
+digit_count(const Int256 *v)
+{
+	char	digits[DC_MAX_DIGITS + 1];
+
+	return decimal_digits(*v, digits);
+}
+
+static size_t
+format_text(const Int256 *v, int scale, char *text)
+{
+	char	digits[DC_MAX_DIGITS + 1];
+	char	*p = text;
+	int	ndigits = decimal_digits(*v, digits), k;
+
+	if (v->negative && !(1 == ndigits && '0' == digits[0]))
+		*p++ = '-';
+	if (scale <= 0)
+	{
+		for (k = ndigits - 1; k >= 0; k--)
+			*p++ = digits[k];
+		if (ndigits > 1 || '0' != digits[0])
+		{
+			memset(p, '0', -scale);
+			p += -scale;
+		}
+	}
+	else
+	{
+		if (ndigits <= scale)
+		{
+			*p++ = '0';
+			*p++ = '.';
+			memset(p, '0', scale - ndigits);
+			p += scale - ndigits;
+		}
+		for (k = ndigits - 1; k >= 0; k--)
+		{
+			*p++ = digits[k];
+			if (k == scale)
+				*p++ = '.';
+		}
+	}
+	return p - text;
+}
+
+size_t
+DC_format_decimal(const void *value, int byte_width, int scale, char *text)
+{
+	Int256	v;
+
+	load_bytes(value, byte_width, &v);
+	return format_text(&v, scale, text);
+}
+
+int
+DC_parse_decimal(const char *s, size_t len, int precision, int scale,
+		 int byte_width, void *value)
+{
+	const char	*end = s + len;
+	Int256	v;
+	int	ndigits = 0, frac_digits = 0, shift;
+	long	exponent = 0;
+	bool	seen_digit = false, in_fraction = false, dropped = false;
+
+	memset(&v, 0, sizeof(v));
+	while (s < end && isspace((UCHAR) *s))
+		s++;
+	while (end > s && isspace((UCHAR) end[-1]))
+		end--;
+	if (s < end && ('-' == *s || '+' == *s))
+		v.negative = '-' == *s++;
+	for (; s < end; s++)
+	{
+		if ('.' == *s && !in_fraction)
+		{
+			in_fraction = true;
+			continue;
+		}
+		if (*s < '0' || *s > '9')
+			break;
+		seen_digit = true;
+		if (0 == ndigits && '0' == *s)
+		{
+			/* leading zeros only move the point */
+			if (in_fraction)
+				frac_digits++;
+			continue;
+		}
+		if (ndigits >= DC_MAX_DIGITS - 1)
+		{
+			/* past what any precision holds: integral digits overflow */
+			if (!in_fraction)
+				return COPY_NUMERIC_OUT_OF_RANGE;
+			dropped |= '0' != *s;
+			continue;
+		}
+		mul_small(&v, 10);
+		v.w[0] += (uint32_t) (*s - '0');
+		ndigits++;
+		if (in_fraction)
+			frac_digits++;
+	}
+	if (!seen_digit)
+		return COPY_INVALID_STRING_CONVERSION;
+	if (s < end && ('e' == *s || 'E' == *s))
+	{
+		bool	negative_exp = false, exp_digit = false;
+
+		if (++s < end && ('-' == *s || '+' == *s))
+			negative_exp = '-' == *s++;
+		for (; s < end && *s >= '0' && *s <= '9'; s++)
+		{
+			exp_digit = true;
+			if (exponent < 100000)
+				exponent = exponent * 10 + (*s - '0');
+		}
+		if (!exp_digit)
+			return COPY_INVALID_STRING_CONVERSION;
+		if (negative_exp)
+			exponent = -exponent;
+	}
+	if (s != end)
+		return COPY_INVALID_STRING_CONVERSION;
+
+	/* v * 10^(exponent - frac_digits) at the target scale */
+	if (!is_zero(&v))
+	{
+		long	n = (long) scale + exponent - frac_digits;
+
+		if (n > 2 * DC_MAX_DIGITS)
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		shift = n < -2 * DC_MAX_DIGITS ? -2 * DC_MAX_DIGITS : (int) n;
+		if (shift > 0 && !scale_up(&v, shift))
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		if (shift < 0 && scale_down(&v, -shift))
+			dropped = true;
+		if (digit_count(&v) > precision && !is_zero(&v))
+			return COPY_NUMERIC_OUT_OF_RANGE;
+	}
+	if (is_zero(&v))
+		v.negative = false;
+	store_bytes(&v, byte_width, value);
+	return dropped ? COPY_FRACTION_TRUNCATED : COPY_OK;
+}
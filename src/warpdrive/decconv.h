@@ -0,0 +1,37 @@
+/* File:			decconv.h
+ *
+ * Description:		See "decconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __DECCONV_H__
+#define __DECCONV_H__
+
+#include "colconv.h"
+
+/* Largest number of digits of a Decimal256 value */
+#define	DC_MAX_DIGITS	77
+/* Room for the plain decimal notation of any value, sign and point included */
+#define	DC_MAX_TEXT	(2 * DC_MAX_DIGITS + 4)
+
+/*
+ *	Plain decimal notation of one Decimal128 or Decimal256 value, given as
+ *	its 'byte_width' little-endian bytes.  Returns the length; 'text' is
+ *	not terminated.
+ */
+size_t	DC_format_decimal(const void *value, int byte_width, int scale, char *text);
+
+/*
+ *	Parse a numeric literal ("-12.5", "1e3") of 'len' characters, blanks
+ *	around it ignored, into a decimal of the given precision and scale
+ *	stored in 'byte_width' little-endian bytes.  Digits past the scale are
+ *	dropped with COPY_FRACTION_TRUNCATED; a value needing more than
+ *	'precision' digits gives COPY_NUMERIC_OUT_OF_RANGE and anything that
+ *	is not a number COPY_INVALID_STRING_CONVERSION.
+ */
+int	DC_parse_decimal(const char *s, size_t len, int precision, int scale,
+			int byte_width, void *value);
+
+#endif /* __DECCONV_H__ */
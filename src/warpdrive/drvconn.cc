@@ -35,6 +35,8 @@
 #include "resource.h"
 #endif
 #include "wdapifunc.h"
+#include "conntime.h"
+#include "transact.h"
 
 #include "dlg_specific.h"
 #include <string>
@@ -114,10 +116,8 @@ WD_DriverConnect(HDBC hdbc,
 	} else {
 		connStr.assign(reinterpret_cast<const char*>(szConnStrIn), cbConnStrIn);
 	}
-	Connection::ConnPropertyMap properties;
-	std::vector<std::string> missing_properties;
-	std::string dsn = ODBCConnection::getPropertiesFromConnString(connStr, properties);
-	conn->connect(dsn, properties, missing_properties);
+	CT_connect(conn, connStr);
+	TX_connected(conn);
 
         // Just copy the input string and write it to the output string on success.
         if (szConnStrOut) {
@@ -0,0 +1,47 @@
+/*-------
+ * Module:			dtconv.cc
+ *
+ * Description:		This module contains the calendar arithmetic of the
+ *					date, time and timestamp parameters: proleptic Gregorian
+ *					dates to and from days since the epoch, computed without
+ *					branches (H. Hinnant, "chrono-Compatible Low-Level Date
+ *					Algorithms").
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "dtconv.h"
+
+void
+DT_civil_from_days(int64_t days, int64_t *year, unsigned *month, unsigned *day)
+{
+	int64_t		z = days + 719468;
+	int64_t		era = (z >= 0 ? z : z - 146096) / 146097;
+	unsigned	doe = (unsigned) (z - era * 146097);
+	unsigned	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	unsigned	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	unsigned	mp = (5 * doy + 2) / 153;
+
+	*day = doy - (153 * mp + 2) / 5 + 1;
+	*month = mp < 10 ? mp + 3 : mp - 9;
+	*year = (int64_t) yoe + era * 400 + (*month <= 2);
+}
+
+int64_t
+DT_days_from_civil(int64_t year, unsigned month, unsigned day)
+{
+	int64_t		era, y = year - (month <= 2);
+	unsigned	yoe, doy, doe;
+
+	era = (y >= 0 ? y : y - 399) / 400;
+	yoe = (unsigned) (y - era * 400);
+	doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + (int64_t) doe - 719468;
+}
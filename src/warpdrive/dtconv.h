@@ -0,0 +1,27 @@
+/* File:			dtconv.h
+ *
+ * Description:		See "dtconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __DTCONV_H__
+#define __DTCONV_H__
+
+#include "colconv.h"
+
+/* Arrow time units, in the order of arrow::TimeUnit */
+typedef enum
+{
+	DT_SECOND = 0,
+	DT_MILLI,
+	DT_MICRO,
+	DT_NANO
+} DT_TimeUnit;
+
+/* Proleptic Gregorian dates and days since 1970-01-01 */
+void	DT_civil_from_days(int64_t days, int64_t *year, unsigned *month, unsigned *day);
+int64_t	DT_days_from_civil(int64_t year, unsigned month, unsigned day);
+
+#endif /* __DTCONV_H__ */
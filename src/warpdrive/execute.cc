@@ -32,12 +32,20 @@
 #include "bind.h"
 #include "wdtypes.h"
 #include "lobj.h"
+#include "paramset.h"
+#include "resinfo.h"
+#include "asyncexec.h"
+#include "stmtbatch.h"
+#include "odbcescape.h"
+#include "transact.h"
 #include "wdapifunc.h"
+#include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/odbc_impl/ODBCStatement.h>
 #include <odbcabstraction/odbc_impl/ODBCConnection.h>
 #include <string>
 
 using namespace ODBC;
+using driver::odbcabstraction::DriverException;
 
 /*		Perform a Prepare on the SQL statement */
 RETCODE		SQL_API
@@ -53,13 +61,31 @@ WD_Prepare(HSTMT hstmt,
 	MYLOG(0, "entering...\n");
 	const char* queryStr = reinterpret_cast<const char*>(szSqlStr);
 	std::string query = std::string(queryStr, SQL_NTS == cbSqlStr ? strlen(queryStr) : cbSqlStr);
+	ES_translate(stmt, query);
+	RI_stale(stmt);
+	SB_discard(stmt);
 	stmt->Prepare(query);
+	PS_set_query(PS_get(stmt, TRUE), query.data(), query.size());
 
     MYLOG(DETAIL_LOG_LEVEL, "leaving %d\n", retval);
 	return retval;
 }
 
 
+/*
+ *	Run an execution of 'stmt'.  The description of the result is checked
+ *	against the new IRD.  In manual commit mode it runs in the
+ *	transaction of the connection.
+ */
+template <typename Execution>
+static RETCODE
+execute_and_track(ODBCStatement *stmt, Execution execution)
+{
+	RI_stale(stmt);
+	TX_work(&stmt->GetConnection());
+	return execution();
+}
+
 /*		Performs the equivalent of SQLPrepare, followed by SQLExecute. */
 RETCODE		SQL_API
 WD_ExecDirect(HSTMT hstmt,
@@ -74,7 +100,25 @@ WD_ExecDirect(HSTMT hstmt,
 
 	const char* queryStr = reinterpret_cast<const char*>(szSqlStr);
 	std::string query = std::string(queryStr, SQL_NTS == cbSqlStr ? strlen(queryStr) : cbSqlStr);
-	stmt->ExecuteDirect(query);
+	if (0 == (flag & PODBC_BATCH_MEMBER))
+	{
+		ES_translate(stmt, query);
+		SB_start(stmt, query);
+	}
+	ParamSet *ps = PS_get(stmt, FALSE);
+
+	result = execute_and_track(stmt, [&]() -> RETCODE {
+		RETCODE	ret = SQL_SUCCESS;
+
+		if (ps)
+		{
+			PS_set_query(ps, query.data(), query.size());
+			if (PS_execute(stmt, ps, &ret))
+				return ret;
+		}
+		stmt->ExecuteDirect(query);
+		return ret;
+	});
 
 	MYLOG(0, "leaving %hd\n", result);
 	return result;
@@ -155,130 +199,6 @@ decideHowToPrepare(StatementClass *stmt, BOOL force)
 	return method;
 }
 
-/* dont/should/can send Parse request ? */
-enum {
-	 doNothing = 0
-	,allowParse
-	,preferParse
-	,shouldParse
-	,usingCommand
-};
-
-#define	ONESHOT_CALL_PARSE		allowParse
-#define	NOPARAM_ONESHOT_CALL_PARSE	doNothing
-
-static
-int HowToPrepareBeforeExec(StatementClass *stmt, BOOL checkOnly)
-{
-	SQLSMALLINT	num_params = stmt->num_params;
-	ConnectionClass	*conn = SC_get_conn(stmt);
-	ConnInfo *ci = &(conn->connInfo);
-	int		nCallParse = doNothing, how_to_prepare = 0;
-	BOOL		bNeedsTrans = FALSE;
-
-	if (num_params < 0)
-		WD_NumParams(stmt, &num_params);
-	how_to_prepare = decideHowToPrepare(stmt, checkOnly);
-	if (checkOnly)
-	{
-		if (num_params <= 0)
-			return doNothing;
-	}
-	else
-	{
-		switch (how_to_prepare)
-		{
-			case NAMED_PARSE_REQUEST:
-				return shouldParse;
-			case PARSE_TO_EXEC_ONCE:
-				switch (stmt->prepared)
-				{
-					case PREPARED_TEMPORARILY:
-						nCallParse = preferParse;
-						break;
-					default:
-						if (num_params <= 0)
-							nCallParse = NOPARAM_ONESHOT_CALL_PARSE;
-						else
-							nCallParse = ONESHOT_CALL_PARSE;
-				}
-				break;
-			default:
-				return doNothing;
-		}
-	}
-
-	if (num_params > 0)
-	{
-		int	param_number = -1;
-		ParameterInfoClass *apara;
-		ParameterImplClass *ipara;
-		OID	wdtype;
-
-		while (TRUE)
-		{
-			SC_param_next(stmt, &param_number, &apara, &ipara);
-			if (!ipara || !apara)
-				break;
-			wdtype = PIC_get_wdtype(*ipara);
-			if (checkOnly)
-			{
-				switch (ipara->SQLType)
-				{
-					case SQL_LONGVARBINARY:
-						if (0 == wdtype)
-						{
-							if (ci->bytea_as_longvarbinary &&
-							    0 != conn->lobj_type)
-								nCallParse = shouldParse;
-						}
-						break;
-					case SQL_CHAR:
-						if (ci->cvt_null_date_string)
-							nCallParse = shouldParse;
-						break;
-					case SQL_VARCHAR:
-						if (ci->drivers.bools_as_char &&
-						    WD_WIDTH_OF_BOOLS_AS_CHAR == ipara->column_size)
-							nCallParse = shouldParse;
-						break;
-				}
-			}
-			else
-			{
-				BOOL	bBytea = FALSE;
-
-				switch (ipara->SQLType)
-				{
-					case SQL_LONGVARBINARY:
-						if (conn->lobj_type == wdtype || WD_TYPE_OID == wdtype)
-							bNeedsTrans = TRUE;
-						else if (WD_TYPE_BYTEA == wdtype)
-							bBytea = TRUE;
-						else if (0 == wdtype)
-						{
-							if (ci->bytea_as_longvarbinary)
-								bBytea = TRUE;
-							else
-								bNeedsTrans = TRUE;
-						}
-						if (bBytea)
-							if (nCallParse < preferParse)
-								nCallParse = preferParse;
-						break;
-				}
-			}
-		}
-	}
-	if (bNeedsTrans &&
-	    PARSE_TO_EXEC_ONCE == how_to_prepare)
-	{
-		if (!CC_is_in_trans(conn) && CC_does_autocommit(conn))
-			nCallParse = doNothing;
-	}
-	return nCallParse;
-}
-
 static
 const char *GetSvpName(const ConnectionClass *conn, char *wrk, int wrksize)
 {
@@ -286,257 +206,6 @@ const char *GetSvpName(const ConnectionClass *conn, char *wrk, int wrksize)
 	return wrk;
 }
 
-/*
- *	The execution after all parameters were resolved.
- */
-
-#define INVALID_EXPBUFFER	PQExpBufferDataBroken(stmt->stmt_deffered)
-#define VALID_EXPBUFFER	(!PQExpBufferDataBroken(stmt->stmt_deffered))
-
-static
-void param_status_batch_update(IPDFields *ipdopts, RETCODE retval, SQLLEN target_row, int count_of_deffered)
-{
-	int i, j;
-	if (NULL != ipdopts->param_status_ptr)
-	{
-		for (i = target_row, j = 0; i >= 0 && j <= count_of_deffered; i--)
-		{
-			if (SQL_PARAM_UNUSED != ipdopts->param_status_ptr[i])
-			{
-				ipdopts->param_status_ptr[i] = retval;
-				j++;
-			}
-		}
-	}
-}
-
-static
-RETCODE	Exec_with_parameters_resolved(StatementClass *stmt, EXEC_TYPE exec_type, BOOL *exec_end)
-{
-	CSTR func = "Exec_with_parameters_resolved";
-	RETCODE		retval;
-	SQLLEN		start_row, end_row;
-	SQLINTEGER	cursor_type, scroll_concurrency;
-	ConnectionClass	*conn;
-	QResultClass	*res;
-	APDFields	*apdopts;
-	IPDFields	*ipdopts;
-	BOOL		prepare_before_exec = FALSE;
-	char *stmt_with_params;
-	SQLLEN		status_row = stmt->exec_current_row;
-	int		count_of_deffered;
-
-	*exec_end = FALSE;
-	conn = SC_get_conn(stmt);
-	MYLOG(0, "copying statement params: trans_status=%d, len=" FORMAT_SIZE_T ", stmt='%s'\n", conn->transact_status, strlen(stmt->statement), stmt->statement);
-
-#define	return	DONT_CALL_RETURN_FROM_HERE???
-#define	RETURN(code)	{ retval = code; goto cleanup; }
-	ENTER_CONN_CS(conn);
-	/* save the cursor's info before the execution */
-	cursor_type = stmt->options.cursor_type;
-	scroll_concurrency = stmt->options.scroll_concurrency;
-	/* Prepare the statement if possible at backend side */
-	if (HowToPrepareBeforeExec(stmt, FALSE) >= allowParse)
-		prepare_before_exec = TRUE;
-
-MYLOG(DETAIL_LOG_LEVEL, "prepare_before_exec=%d srv=%d\n", prepare_before_exec, stmt->use_server_side_prepare);
-	/* Create the statement with parameters substituted. */
-	stmt_with_params = stmt->stmt_with_params;
-	if (LAST_EXEC == exec_type)
-	{
-		if (NULL != stmt_with_params)
-		{
-			free(stmt_with_params);
-			stmt_with_params = stmt->stmt_with_params = NULL;
-		}
-		if (INVALID_EXPBUFFER ||
-		    !stmt->stmt_deffered.data[0])
-			RETURN(SQL_SUCCESS);
-	}
-	else
-	{
-		retval = copy_statement_with_parameters(stmt, prepare_before_exec);
-		stmt->current_exec_param = -1;
-		if (retval != SQL_SUCCESS)
-		{
-			stmt->exec_current_row = -1;
-			*exec_end = TRUE;
-			RETURN(retval) /* error msg is passed from the above */
-		}
-		stmt_with_params = stmt->stmt_with_params;
-		if (!stmt_with_params) // Extended Protocol
-			exec_type = DIRECT_EXEC;
-	}
-
-	MYLOG(0, "   stmt_with_params = '%s'\n", stmt->stmt_with_params);
-
-	/*
-	 *	The real execution.
-	 */
-MYLOG(0, "about to begin SC_execute exec_type=%d\n", exec_type);
-	ipdopts = SC_get_IPDF(stmt);
-	apdopts = SC_get_APDF(stmt);
-	if (start_row = stmt->exec_start_row, start_row < 0)
-		start_row = 0;
-	if (end_row = stmt->exec_end_row, end_row < 0)
-	{
-		end_row = (SQLINTEGER) apdopts->paramset_size - 1;
-		if (end_row < 0)
-			end_row = 0;
-	}
-	if (LAST_EXEC == exec_type &&
-	    NULL != ipdopts->param_status_ptr)
-	{
-		int i;
-		for (i = end_row; i >= start_row; i--)
-		{
-			if (SQL_PARAM_UNUSED != ipdopts->param_status_ptr[i])
-			{
-				status_row = i;
-				break;
-			}
-		}
-	}
-	count_of_deffered = stmt->count_of_deffered;
-	if (DIRECT_EXEC == exec_type)
-	{
-		retval = SC_execute(stmt);
-		stmt->count_of_deffered = 0;
-	}
-	else if (DEFFERED_EXEC == exec_type &&
-		 stmt->exec_current_row < end_row &&
-		 stmt->count_of_deffered + 1 < stmt->batch_size)
-	{
-		if (INVALID_EXPBUFFER)
-			initPQExpBuffer(&stmt->stmt_deffered);
-		if (INVALID_EXPBUFFER)
-		{
-			retval = SQL_ERROR;
-			SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Out of memory", __FUNCTION__); 
-		}
-		else
-		{
-			if (NULL != stmt_with_params)
-			{
-				if (stmt->stmt_deffered.data[0])
-					appendPQExpBuffer(&stmt->stmt_deffered, ";%s", stmt_with_params);
-				else
-					printfPQExpBuffer(&stmt->stmt_deffered, "%s", stmt_with_params);
-			}
-			if (NULL != ipdopts->param_status_ptr)
-				ipdopts->param_status_ptr[stmt->exec_current_row] = SQL_PARAM_SUCCESS; // set without exec
-			stmt->count_of_deffered++;
-			stmt->exec_current_row++;
-			RETURN(SQL_SUCCESS);
-		}
-	}
-	else
-	{
-/*		if (VALID_EXPBUFFER)
-		{
-			if (NULL != stmt_with_params)
-				appendPQExpBuffer(&stmt->stmt_deffered, ";%s", stmt_with_params);
-			stmt->stmt_with_params = stmt->stmt_deffered.data;
-		}*/
-		retval = SC_execute(stmt);
-		stmt->stmt_with_params = stmt_with_params;
-		stmt->count_of_deffered = 0;
-//		if (VALID_EXPBUFFER)
-//			resetPQExpBuffer(&stmt->stmt_deffered);
-	}
-	if (retval == SQL_ERROR)
-	{
-MYLOG(0, "count_of_deffered=%d\n", count_of_deffered);
-		param_status_batch_update(ipdopts, SQL_PARAM_ERROR, stmt->exec_current_row, count_of_deffered);
-		stmt->exec_current_row = -1;
-		*exec_end = TRUE;
-		RETURN(retval)
-	}
-	res = SC_get_Result(stmt);
-	/* special handling of result for keyset driven cursors */
-	if (SQL_CURSOR_KEYSET_DRIVEN == stmt->options.cursor_type &&
-	    SQL_CONCUR_READ_ONLY != stmt->options.scroll_concurrency)
-	{
-		QResultClass	*kres;
-
-		if (kres = QR_nextr(res), kres)
-		{
-			QR_set_fields(kres, QR_get_fields(res));
-			QR_set_fields(res,  NULL);
-			kres->num_fields = res->num_fields;
-			QR_detach(res);
-			SC_set_Result(stmt, kres);
-			res = kres;
-		}
-	}
-	ipdopts = SC_get_IPDF(stmt);
-	if (ipdopts->param_status_ptr)
-	{
-		switch (retval)
-		{
-			case SQL_SUCCESS:
-				ipdopts->param_status_ptr[status_row] = SQL_PARAM_SUCCESS;
-				break;
-			case SQL_SUCCESS_WITH_INFO:
-MYLOG(0, "count_of_deffered=%d has_notice=%d\n", count_of_deffered, stmt->has_notice);
-				param_status_batch_update(ipdopts, (count_of_deffered > 0 && !stmt->has_notice) ? SQL_PARAM_SUCCESS : SQL_PARAM_SUCCESS_WITH_INFO, status_row, count_of_deffered);
-				break;
-			default:
-				param_status_batch_update(ipdopts, SQL_PARAM_ERROR, status_row, count_of_deffered);
-				break;
-		}
-	}
-	stmt->has_notice = 0;
-	if (stmt->exec_current_row >= end_row)
-	{
-		*exec_end = TRUE;
-		stmt->exec_current_row = -1;
-	}
-	else
-		stmt->exec_current_row++;
-	if (res)
-	{
-		EnvironmentClass *env = (EnvironmentClass *) CC_get_env(conn);
-		const char *cmd = QR_get_command(res);
-
-		if (retval == SQL_SUCCESS &&
-		    NULL != cmd &&
-		    start_row >= end_row &&
-		    NULL != env &&
-		    EN_is_odbc3(env))
-		{
-			int     count;
-
-			if (sscanf(cmd , "UPDATE %d", &count) == 1)
-				;
-			else if (sscanf(cmd , "DELETE %d", &count) == 1)
-				;
-			else
-				count = -1;
-			if (0 == count)
-				retval = SQL_NO_DATA;
-		}
-		stmt->diag_row_count = res->recent_processed_row_count;
-	}
-	/*
-	 *	The cursor's info was changed ?
-	 */
-	if (retval == SQL_SUCCESS &&
-	    (stmt->options.cursor_type != cursor_type ||
-	     stmt->options.scroll_concurrency != scroll_concurrency))
-	{
-		SC_set_error(stmt, STMT_OPTION_VALUE_CHANGED, "cursor updatability changed", func);
-		retval = SQL_SUCCESS_WITH_INFO;
-	}
-
-cleanup:
-#undef	RETURN
-#undef	return
-	LEAVE_CONN_CS(conn);
-	return retval;
-}
-
 int
 StartRollbackState(StatementClass *stmt)
 {
@@ -813,8 +482,17 @@ WD_Execute(HSTMT hstmt, UWORD flag)
 	CSTR func = "WD_Execute";
 	ODBCStatement* stmt = reinterpret_cast<ODBCStatement*>(hstmt);
 	RETCODE		retval = SQL_SUCCESS;
+	ParamSet *ps = PS_get(stmt, FALSE);
+
 	MYLOG(0, "entering...\n");
-	stmt->ExecutePrepared();
+	retval = execute_and_track(stmt, [&]() -> RETCODE {
+		RETCODE	ret = SQL_SUCCESS;
+
+		if (ps && PS_execute(stmt, ps, &ret))
+			return ret;
+		stmt->ExecutePrepared();
+		return ret;
+	});
 	return retval;
 }
 
@@ -888,6 +566,7 @@ WD_Cancel(HSTMT hstmt)		/* Statement to cancel. */
 {
 	CSTR func = "WD_Cancel";
   ODBCStatement* stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+  AE_cancel(stmt);
   stmt->Cancel();
 
   return SQL_SUCCESS;
@@ -909,23 +588,30 @@ WD_NativeSql(HDBC hdbc,
 {
 	CSTR func = "WD_NativeSql";
 	size_t		len = 0;
-	const char	   *ptr;
+	std::string	query;
 	RETCODE		result;
 
 	MYLOG(0, "entering...cbSqlStrIn=" FORMAT_INTEGER "\n", cbSqlStrIn);
 
-	ptr = (cbSqlStrIn == 0) ? "" : make_string(szSqlStrIn, cbSqlStrIn, NULL, 0);
-	if (!ptr)
+	if (cbSqlStrIn != 0)
 	{
+		char	*ptr = make_string(szSqlStrIn, cbSqlStrIn, NULL, 0);
+
+		if (!ptr)
+		{
           throw std::bad_alloc();
+		}
+		query = ptr;
+		free(ptr);
 	}
+	ES_native(query);
 
 	result = SQL_SUCCESS;
-	len = strlen(ptr);
+	len = query.size();
 
 	if (szSqlStr)
 	{
-		strncpy_null((char *) szSqlStr, ptr, cbSqlStrMax);
+		strncpy_null((char *) szSqlStr, query.c_str(), cbSqlStrMax);
 
 		if (len >= cbSqlStrMax)
 		{
@@ -937,9 +623,6 @@ WD_NativeSql(HDBC hdbc,
 	if (pcbSqlStr)
 		*pcbSqlStr = (SQLINTEGER) len;
 
-//	if (cbSqlStrIn)
-//		free(ptr);
-
 	return result;
 }
 
@@ -952,130 +635,19 @@ RETCODE		SQL_API
 WD_ParamData(HSTMT hstmt,
 				PTR * prgbValue)
 {
-	CSTR func = "WD_ParamData";
-	StatementClass *stmt = (StatementClass *) hstmt, *estmt;
-	APDFields	*apdopts;
-	IPDFields	*ipdopts;
+	ODBCStatement *stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+	ParamSet *ps = PS_get(stmt, FALSE);
 	RETCODE		retval;
-	int		i;
-	Int2		num_p;
-	ConnectionClass	*conn = NULL;
 
 	MYLOG(0, "entering...\n");
-
-	conn = SC_get_conn(stmt);
-
-	estmt = stmt->execute_delegate ? stmt->execute_delegate : stmt;
-	apdopts = SC_get_APDF(estmt);
-	MYLOG(0, "\tdata_at_exec=%d, params_alloc=%d\n", estmt->data_at_exec, apdopts->allocated);
-
-#define	return	DONT_CALL_RETURN_FROM_HERE???
-	if (SC_AcceptedCancelRequest(stmt))
-	{
-		SC_set_error(stmt, STMT_OPERATION_CANCELLED, "Cancel the statement, sorry", func);
-		retval = SQL_ERROR;
-		goto cleanup;
-	}
-	if (estmt->data_at_exec < 0)
-	{
-		SC_set_error(stmt, STMT_SEQUENCE_ERROR, "No execution-time parameters for this statement", func);
-		retval = SQL_ERROR;
-		goto cleanup;
-	}
-
-	if (estmt->data_at_exec > apdopts->allocated)
-	{
-		SC_set_error(stmt, STMT_SEQUENCE_ERROR, "Too many execution-time parameters were present", func);
-		retval = SQL_ERROR;
-		goto cleanup;
-	}
-
-	/* close the large object */
-	if (estmt->lobj_fd >= 0)
-	{
-		odbc_lo_close(conn, estmt->lobj_fd);
-
-		/* commit transaction if needed */
-		if (!CC_cursor_count(conn) && CC_does_autocommit(conn))
-		{
-			if (!CC_commit(conn))
-			{
-				SC_set_error(stmt, STMT_EXEC_ERROR, "Could not commit (in-line) a transaction", func);
-				retval = SQL_ERROR;
-				goto cleanup;
-			}
-		}
-		estmt->lobj_fd = -1;
-	}
-
-	/* Done, now copy the params and then execute the statement */
-	ipdopts = SC_get_IPDF(estmt);
-MYLOG(DETAIL_LOG_LEVEL, "ipdopts=%p\n", ipdopts);
-	if (estmt->data_at_exec == 0)
-	{
-		BOOL	exec_end;
-		UWORD	flag = SC_is_with_hold(stmt) ? PODBC_WITH_HOLD : 0;
-
-		retval = Exec_with_parameters_resolved(estmt, stmt->exec_type, &exec_end);
-		if (exec_end)
-		{
-			/**SC_reset_delegate(retval, stmt);**/
-			retval = dequeueNeedDataCallback(retval, stmt);
-			goto cleanup;
-		}
-
-		if (retval = WD_Execute(estmt, flag), SQL_NEED_DATA != retval)
-		{
-			goto cleanup;
-		}
-	}
-
-	/*
-	 * Set beginning param;  if first time SQLParamData is called , start
-	 * at 0. Otherwise, start at the last parameter + 1.
-	 */
-	i = estmt->current_exec_param >= 0 ? estmt->current_exec_param + 1 : 0;
-
-	num_p = estmt->num_params;
-	if (num_p < 0)
-		WD_NumParams(estmt, &num_p);
-MYLOG(DETAIL_LOG_LEVEL, "i=%d allocated=%d num_p=%d\n", i, apdopts->allocated, num_p);
-	if (num_p > apdopts->allocated)
-		num_p = apdopts->allocated;
-	/* At least 1 data at execution parameter, so Fill in the token value */
-	for (; i < num_p; i++)
-	{
-MYLOG(DETAIL_LOG_LEVEL, "i=%d", i);
-		if (apdopts->parameters[i].data_at_exec)
-		{
-MYPRINTF(DETAIL_LOG_LEVEL, " at exec buffer=%p", apdopts->parameters[i].buffer);
-			estmt->data_at_exec--;
-			estmt->current_exec_param = i;
-			estmt->put_data = FALSE;
-			if (prgbValue)
-			{
-				/* returns token here */
-				if (stmt->execute_delegate)
-				{
-					SQLULEN	offset = apdopts->param_offset_ptr ? *apdopts->param_offset_ptr : 0;
-					SQLLEN	perrow = apdopts->param_bind_type > 0 ? apdopts->param_bind_type : apdopts->parameters[i].buflen;
-
-MYPRINTF(DETAIL_LOG_LEVEL, " offset=" FORMAT_LEN " perrow=" FORMAT_LEN, offset, perrow);
-					*prgbValue = apdopts->parameters[i].buffer + offset + estmt->exec_current_row * perrow;
-				}
-				else
-					*prgbValue = apdopts->parameters[i].buffer;
-			}
-			break;
-		}
-MYPRINTF(DETAIL_LOG_LEVEL, "\n");
-	}
-
-	retval = SQL_NEED_DATA;
-MYLOG(DETAIL_LOG_LEVEL, "return SQL_NEED_DATA\n");
-cleanup:
-#undef	return
-	SC_setInsertedTable(stmt, retval);
+	if (!ps)
+		throw DriverException("No execution-time parameters for this statement", "HY010");
+	retval = PS_param_data(stmt, ps, prgbValue);
+	/* the statement runs once, after the last value */
+	if (SQL_NEED_DATA != retval)
+		retval = execute_and_track(stmt, [&]() -> RETCODE {
+			return PS_execute_data(stmt, ps);
+		});
 	MYLOG(0, "leaving %d\n", retval);
 	return retval;
 }
@@ -1090,234 +662,12 @@ WD_PutData(HSTMT hstmt,
 			  PTR rgbValue,
 			  SQLLEN cbValue)
 {
-	CSTR func = "WD_PutData";
-	StatementClass *stmt = (StatementClass *) hstmt, *estmt;
-	ConnectionClass *conn;
-	RETCODE		retval = SQL_SUCCESS;
-	APDFields	*apdopts;
-	IPDFields	*ipdopts;
-	PutDataInfo	*pdata;
-	SQLLEN		old_pos;
-	ParameterInfoClass *current_param;
-	ParameterImplClass *current_iparam;
-	PutDataClass	*current_pdata;
-	char	   *putbuf, *allocbuf = NULL;
-	Int2		ctype;
-	SQLLEN		putlen;
-	BOOL		lenset = FALSE, handling_lo = FALSE;
+	ODBCStatement *stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+	ParamSet *ps = PS_get(stmt, FALSE);
 
 	MYLOG(0, "entering...\n");
-
-#define	return	DONT_CALL_RETURN_FROM_HERE???
-	if (SC_AcceptedCancelRequest(stmt))
-	{
-		SC_set_error(stmt, STMT_OPERATION_CANCELLED, "Cancel the statement, sorry.", func);
-		retval = SQL_ERROR;
-		goto cleanup;
-	}
-
-	estmt = stmt->execute_delegate ? stmt->execute_delegate : stmt;
-	apdopts = SC_get_APDF(estmt);
-	if (estmt->current_exec_param < 0)
-	{
-		SC_set_error(stmt, STMT_SEQUENCE_ERROR, "Previous call was not SQLPutData or SQLParamData", func);
-		retval = SQL_ERROR;
-		goto cleanup;
-	}
-
-	current_param = &(apdopts->parameters[estmt->current_exec_param]);
-	ipdopts = SC_get_IPDF(estmt);
-	current_iparam = &(ipdopts->parameters[estmt->current_exec_param]);
-	pdata = SC_get_PDTI(estmt);
-	current_pdata = &(pdata->pdata[estmt->current_exec_param]);
-	ctype = current_param->CType;
-
-	conn = SC_get_conn(estmt);
-	if (ctype == SQL_C_DEFAULT)
-	{
-		ctype = sqltype_to_default_ctype(conn, current_iparam->SQLType);
-#ifdef	UNICODE_SUPPORT
-		if (SQL_C_WCHAR == ctype &&
-		    CC_default_is_c(conn))
-			ctype = SQL_C_CHAR;
-#endif
-	}
-	if (SQL_NTS == cbValue)
-	{
-#ifdef	UNICODE_SUPPORT
-		if (SQL_C_WCHAR == ctype)
-		{
-			putlen = WCLEN * wcsstrlen((SQLWCHAR *) rgbValue);
-			lenset = TRUE;
-		}
-		else
-#endif /* UNICODE_SUPPORT */
-		if (SQL_C_CHAR == ctype)
-		{
-			putlen = strlen(static_cast<const char*>(rgbValue));
-			lenset = TRUE;
-		}
-	}
-	if (!lenset)
-	{
-		if (cbValue < 0)
-			putlen = cbValue;
-		else
-#ifdef	UNICODE_SUPPORT
-		if (ctype == SQL_C_CHAR || ctype == SQL_C_BINARY || ctype == SQL_C_WCHAR)
-#else
-		if (ctype == SQL_C_CHAR || ctype == SQL_C_BINARY)
-#endif /* UNICODE_SUPPORT */
-			putlen = cbValue;
-		else
-			putlen = ctype_length(ctype);
-	}
-	putbuf = static_cast<char*>(rgbValue);
-	handling_lo = (PIC_dsp_wdtype(conn, *current_iparam) == conn->lobj_type);
-	if (handling_lo && SQL_C_CHAR == ctype)
-	{
-		allocbuf = static_cast<char*>(malloc(putlen / 2 + 1));
-		if (allocbuf)
-		{
-			WD_hex2bin(static_cast<const char*>(rgbValue), allocbuf, putlen);
-			putbuf = allocbuf;
-			putlen /= 2;
-		}
-	}
-
-	if (!estmt->put_data)
-	{							/* first call */
-		MYLOG(0, "(1) cbValue = " FORMAT_LEN "\n", cbValue);
-
-		estmt->put_data = TRUE;
-
-		current_pdata->EXEC_used = (SQLLEN *) malloc(sizeof(SQLLEN));
-		if (!current_pdata->EXEC_used)
-		{
-			SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Out of memory in WD_PutData (1)", func);
-			retval = SQL_ERROR;
-			goto cleanup;
-		}
-
-		*current_pdata->EXEC_used = putlen;
-
-		if (cbValue == SQL_NULL_DATA)
-		{
-			retval = SQL_SUCCESS;
-			goto cleanup;
-		}
-
-		/* Handle Long Var Binary with Large Objects */
-		/* if (current_iparam->SQLType == SQL_LONGVARBINARY) */
-		if (handling_lo)
-		{
-			/* begin transaction if needed */
-			if (!CC_is_in_trans(conn))
-			{
-				if (!CC_begin(conn))
-				{
-					SC_set_error(stmt, STMT_EXEC_ERROR, "Could not begin (in-line) a transaction", func);
-					retval = SQL_ERROR;
-					goto cleanup;
-				}
-			}
-
-			/* store the oid */
-			current_pdata->lobj_oid = odbc_lo_creat(conn, INV_READ | INV_WRITE);
-			if (current_pdata->lobj_oid == 0)
-			{
-				SC_set_error(stmt, STMT_EXEC_ERROR, "Couldnt create large object.", func);
-				retval = SQL_ERROR;
-				goto cleanup;
-			}
-
-			/*
-			 * major hack -- to allow convert to see somethings there have
-			 * to modify convert to handle this better
-			 */
-			/***current_param->EXEC_buffer = (char *) &current_param->lobj_oid;***/
-
-			/* store the fd */
-			estmt->lobj_fd = odbc_lo_open(conn, current_pdata->lobj_oid, INV_WRITE);
-			if (estmt->lobj_fd < 0)
-			{
-				SC_set_error(stmt, STMT_EXEC_ERROR, "Couldnt open large object for writing.", func);
-				retval = SQL_ERROR;
-				goto cleanup;
-			}
-
-			retval = odbc_lo_write(conn, estmt->lobj_fd, putbuf, (Int4) putlen);
-			MYLOG(0, "lo_write: cbValue=" FORMAT_LEN ", wrote %d bytes\n", putlen, retval);
-		}
-		else
-		{
-			current_pdata->EXEC_buffer = static_cast<char*>(malloc(putlen + 1));
-			if (!current_pdata->EXEC_buffer)
-			{
-				SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Out of memory in WD_PutData (2)", func);
-				retval = SQL_ERROR;
-				goto cleanup;
-			}
-			memcpy(current_pdata->EXEC_buffer, putbuf, putlen);
-			current_pdata->EXEC_buffer[putlen] = '\0';
-		}
-	}
-	else
-	{
-		/* calling SQLPutData more than once */
-		MYLOG(0, "(>1) cbValue = " FORMAT_LEN "\n", cbValue);
-
-		/* if (current_iparam->SQLType == SQL_LONGVARBINARY) */
-		if (handling_lo)
-		{
-			/* the large object fd is in EXEC_buffer */
-			retval = odbc_lo_write(conn, estmt->lobj_fd, putbuf, (Int4) putlen);
-			MYLOG(0, "lo_write(2): cbValue = " FORMAT_LEN ", wrote %d bytes\n", putlen, retval);
-
-			*current_pdata->EXEC_used += putlen;
-		}
-		else
-		{
-			old_pos = *current_pdata->EXEC_used;
-			if (putlen > 0)
-			{
-				SQLLEN	used = *current_pdata->EXEC_used + putlen;
-				SQLLEN allocsize;
-				char *buffer;
-
-				for (allocsize = (1 << 4); allocsize <= used; allocsize <<= 1) ;
-				MYLOG(0, "        cbValue = " FORMAT_LEN ", old_pos = " FORMAT_LEN ", *used = " FORMAT_LEN "\n", putlen, old_pos, used);
-
-				/* dont lose the old pointer in case out of memory */
-				buffer = static_cast<char*>(realloc(current_pdata->EXEC_buffer, allocsize));
-				if (!buffer)
-				{
-					SC_set_error(stmt, STMT_NO_MEMORY_ERROR,"Out of memory in WD_PutData (3)", func);
-					retval = SQL_ERROR;
-					goto cleanup;
-				}
-
-				memcpy(&buffer[old_pos], putbuf, putlen);
-				buffer[used] = '\0';
-
-				/* reassign buffer incase realloc moved it */
-				*current_pdata->EXEC_used = used;
-				current_pdata->EXEC_buffer = buffer;
-			}
-			else
-			{
-				SC_set_error(stmt, STMT_INTERNAL_ERROR, "bad cbValue", func);
-				retval = SQL_ERROR;
-				goto cleanup;
-			}
-		}
-	}
-
-	retval = SQL_SUCCESS;
-cleanup:
-#undef	return
-	if (allocbuf)
-		free(allocbuf);
-
-	return retval;
+	if (!ps)
+		throw DriverException("No execution-time parameter is waiting for data", "HY010");
+	PS_put_data(stmt, ps, rgbValue, cbValue);
+	return SQL_SUCCESS;
 }
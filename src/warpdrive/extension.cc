@@ -0,0 +1,136 @@
+/*-------
+ * Module:			extension.cc
+ *
+ * Description:		This module contains what the driver keeps for each
+ *					statement and connection handle beside the objects of
+ *					the abstraction layer: parameter sets, result
+ *					descriptions, batches, asynchronous calls, transaction
+ *					state and connect times.
+ *
+ *					The ODBCStatement and ODBCConnection classes have no
+ *					room for them, so each handle is mapped to one
+ *					extension holding a member per module.  The map is
+ *					looked up once per use under a single lock; the members
+ *					are then reached through the extension.
+ *
+ * Classes:			StatementExt, ConnectionExt
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "extension.h"
+#include "mylog.h"
+
+#include <unordered_map>
+
+using ODBC::ODBCConnection;
+using ODBC::ODBCStatement;
+
+static std::mutex	extensions_lock;
+static std::unordered_map<ODBCStatement *, StatementExt *>	statements;
+static std::unordered_map<ODBCConnection *, ConnectionExt *>	connections;
+
+/* Under extensions_lock */
+static StatementExt *
+stmt_ext(ODBCStatement *stmt)
+{
+	std::unordered_map<ODBCStatement *, StatementExt *>::iterator	it = statements.find(stmt);
+	StatementExt	*ext;
+
+	if (it != statements.end())
+		return it->second;
+	ext = new StatementExt();
+	ext->conn = NULL;
+	ext->params = NULL;
+	ext->result = NULL;
+	ext->batch = NULL;
+	ext->async = NULL;
+	ext->noscan = FALSE;
+	statements[stmt] = ext;
+	return ext;
+}
+
+StatementExt *
+EX_stmt(ODBCStatement *stmt)
+{
+	std::lock_guard<std::mutex>	lock(extensions_lock);
+
+	return stmt_ext(stmt);
+}
+
+ConnectionExt *
+EX_conn(ODBCConnection *conn)
+{
+	std::lock_guard<std::mutex>	lock(extensions_lock);
+	std::unordered_map<ODBCConnection *, ConnectionExt *>::iterator	it = connections.find(conn);
+	ConnectionExt	*ext;
+
+	if (it != connections.end())
+		return it->second;
+	ext = new ConnectionExt();
+	ext->transaction = NULL;
+	ext->times = NULL;
+	ext->async = NULL;
+	ext->async_enable = SQL_ASYNC_ENABLE_OFF;
+	connections[conn] = ext;
+	return ext;
+}
+
+void
+EX_attach(ODBCConnection *conn, ODBCStatement *stmt)
+{
+	std::lock_guard<std::mutex>	lock(extensions_lock);
+
+	stmt_ext(stmt)->conn = conn;
+}
+
+void
+EX_statements(ODBCConnection *conn, std::vector<ODBCStatement *> &stmts)
+{
+	std::lock_guard<std::mutex>	lock(extensions_lock);
+	std::unordered_map<ODBCStatement *, StatementExt *>::iterator	it;
+
+	for (it = statements.begin(); it != statements.end(); it++)
+		if (it->second->conn == conn)
+			stmts.push_back(it->first);
+}
+
+void
+EX_forget_stmt(ODBCStatement *stmt)
+{
+	StatementExt	*ext;
+
+	{
+		std::lock_guard<std::mutex>	lock(extensions_lock);
+		std::unordered_map<ODBCStatement *, StatementExt *>::iterator	it = statements.find(stmt);
+
+		if (it == statements.end())
+			return;
+		ext = it->second;
+		statements.erase(it);
+	}
+	MYLOG(DETAIL_LOG_LEVEL, "stmt=%p forgotten\n", stmt);
+	delete ext;
+}
+
+void
+EX_forget_conn(ODBCConnection *conn)
+{
+	ConnectionExt	*ext;
+
+	{
+		std::lock_guard<std::mutex>	lock(extensions_lock);
+		std::unordered_map<ODBCConnection *, ConnectionExt *>::iterator	it = connections.find(conn);
+
+		if (it == connections.end())
+			return;
+		ext = it->second;
+		connections.erase(it);
+	}
+	MYLOG(DETAIL_LOG_LEVEL, "conn=%p forgotten\n", conn);
+	delete ext;
+}
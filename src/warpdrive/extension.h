@@ -0,0 +1,76 @@
+/* File:			extension.h
+ *
+ * Description:		See "extension.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __EXTENSION_H__
+#define __EXTENSION_H__
+
+#include "wdodbc.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ODBC
+{
+  class ODBCConnection;
+  class ODBCStatement;
+}
+
+typedef struct AsyncState_ AsyncState;
+typedef struct Batch_ Batch;
+typedef struct ConnectTimes_ ConnectTimes;
+typedef struct ParamSet_ ParamSet;
+typedef struct ResultInfo_ ResultInfo;
+typedef struct Transaction_ Transaction;
+
+/*
+ *	What the driver keeps for a statement beside its ODBCStatement.  Each
+ *	member belongs to the module named: it is NULL until the module first
+ *	needs it, and the module frees it when the statement is forgotten.
+ */
+typedef struct
+{
+	ODBC::ODBCConnection	*conn;		/* NULL for a statement the driver made for itself */
+	std::mutex	lock;			/* for the members another thread may use */
+	ParamSet	*params;		/* paramset.cc */
+	ResultInfo	*result;		/* resinfo.cc */
+	Batch		*batch;			/* stmtbatch.cc, under 'lock' */
+	AsyncState	*async;			/* asyncexec.cc, under its own lock */
+	BOOL		noscan;			/* SQL_ATTR_NOSCAN, odbcescape.cc */
+} StatementExt;
+
+/* What the driver keeps for a connection, the same way */
+typedef struct
+{
+	std::mutex	lock;
+	Transaction	*transaction;		/* transact.cc, under 'lock' */
+	ConnectTimes	*times;			/* conntime.cc, under 'lock' */
+	AsyncState	*async;			/* asyncexec.cc, under its own lock */
+	SQLULEN		async_enable;		/* SQL_ATTR_ASYNC_ENABLE of its statements, likewise */
+} ConnectionExt;
+
+/*
+ *	The extension of 'stmt' or 'conn', made when there is none.  It stays
+ *	where it is until the handle is forgotten.
+ */
+StatementExt	*EX_stmt(ODBC::ODBCStatement *stmt);
+ConnectionExt	*EX_conn(ODBC::ODBCConnection *conn);
+
+/* SQLAllocHandle: 'stmt' belongs to 'conn' */
+void	EX_attach(ODBC::ODBCConnection *conn, ODBC::ODBCStatement *stmt);
+
+/* The statements that belong to 'conn', into 'stmts' */
+void	EX_statements(ODBC::ODBCConnection *conn, std::vector<ODBC::ODBCStatement *> &stmts);
+
+/*
+ *	Free the extension of a statement or connection being freed, once the
+ *	modules have freed their members.
+ */
+void	EX_forget_stmt(ODBC::ODBCStatement *stmt);
+void	EX_forget_conn(ODBC::ODBCConnection *conn);
+
+#endif /* __EXTENSION_H__ */
@@ -0,0 +1,31 @@
+/*-------
+ * Module:			hexconv.cc
+ *
+ * Description:		This module contains the hex encoding of binary values,
+ *					for the binary parameters inlined as X'...' literals
+ *					or as text.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "hexconv.h"
+
+size_t
+HX_encode(const UCHAR *src, size_t len, char *dst)
+{
+	static const char digits[] = "0123456789ABCDEF";
+	size_t	i;
+
+	for (i = 0; i < len; i++)
+	{
+		dst[2 * i] = digits[src[i] >> 4];
+		dst[2 * i + 1] = digits[src[i] & 0xf];
+	}
+	return 2 * len;
+}
@@ -0,0 +1,22 @@
+/* File:			hexconv.h
+ *
+ * Description:		See "hexconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __HEXCONV_H__
+#define __HEXCONV_H__
+
+#include "wdodbc.h"
+
+#include <stddef.h>
+
+/*
+ *	Write the 2 * 'len' upper case hex digits of 'src' into 'dst'.  No
+ *	terminator is written.  Returns the number of digits written.
+ */
+size_t	HX_encode(const UCHAR *src, size_t len, char *dst);
+
+#endif /* __HEXCONV_H__ */
@@ -41,6 +41,11 @@
 #include "wdapifunc.h"
 #include "multibyte.h"
 #include "catfunc.h"
+#include "resinfo.h"
+#include "asyncexec.h"
+#include "bulkops.h"
+#include "stmtbatch.h"
+#include "transact.h"
 #include <odbcabstraction/odbc_impl/ODBCConnection.h>
 #include <odbcabstraction/odbc_impl/ODBCStatement.h>
 #include <string>
@@ -91,7 +96,12 @@ WD_GetInfo(HDBC hdbc,
 	}
 
     ODBCConnection* conn = reinterpret_cast<ODBCConnection*>(hdbc);
+    if (AE_get_info(fInfoType, rgbInfoValue, pcbInfoValue) ||
+        SB_get_info(fInfoType, rgbInfoValue, pcbInfoValue) ||
+        TX_get_info(conn, fInfoType, rgbInfoValue, pcbInfoValue))
+        return SQL_SUCCESS;
     conn->GetInfo(fInfoType, rgbInfoValue, cbInfoValueMax, pcbInfoValue, UnicodeOption);
+    BO_adjust_info(fInfoType, rgbInfoValue);
 
 	return SQL_SUCCESS;
 }
@@ -115,6 +125,8 @@ WD_GetTypeInfo(HSTMT hstmt,
 {
 	CSTR func = "WD_GetTypeInfo";
 	ODBCStatement* statement = reinterpret_cast<ODBCStatement*>(hstmt);
+	RI_stale(statement);
+	SB_discard(statement);
 	statement->GetTypeInfo(fSqlType);
 	return SQL_SUCCESS;
 }
@@ -194,7 +206,7 @@ WD_GetFunctions(HDBC hdbc,
 		pfExists[SQL_API_SQLSETPOS] = TRUE;
 		pfExists[SQL_API_SQLSETSCROLLOPTIONS] = TRUE;		/* odbc 1.0 */
 		pfExists[SQL_API_SQLTABLEPRIVILEGES] = TRUE;
-		pfExists[SQL_API_SQLBULKOPERATIONS] = FALSE;
+		pfExists[SQL_API_SQLBULKOPERATIONS] = TRUE;
 	}
 	else
 	{
@@ -331,7 +343,7 @@ WD_GetFunctions(HDBC hdbc,
 				*pfExists = TRUE;
 				break;
 			case SQL_API_SQLBULKOPERATIONS:	/* 24 */
-				*pfExists = FALSE;
+				*pfExists = TRUE;
 				break;
 			case SQL_API_SQLALLOCHANDLE:	/* 1001 */
 			case SQL_API_SQLBINDPARAM:	/* 1002 */
@@ -584,6 +596,8 @@ WD_Tables(HSTMT hstmt,
 	  type = std::string(typeCstr, cbTableType == SQL_NTS ? strlen(typeCstr) : cbTableType);
 	}
 
+	RI_stale(statement);
+	SB_discard(statement);
 	statement->GetTables(szTableQualifier ? &qualifier : nullptr, 
 	  szTableOwner ? &owner : nullptr,
 	  szTableName ? &name : nullptr,
@@ -682,6 +696,8 @@ WD_Columns(HSTMT hstmt,
 	  colName = std::string(colCstr, cbColumnName == SQL_NTS ? strlen(colCstr) : cbColumnName);
 	}
 
+	RI_stale(statement);
+	SB_discard(statement);
 	statement->GetColumns(szTableQualifier ? &qualifier : nullptr, 
 	  szTableOwner ? &owner : nullptr,
 	  szTableName ? &name : nullptr,
@@ -709,6 +725,8 @@ WD_ForeignKeys(HSTMT hstmt,
 	ODBCStatement* statement = reinterpret_cast<ODBCStatement*>(hstmt);
 
 	MYLOG(0, "Entering\n");
+	RI_stale(statement);
+	SB_discard(statement);
 	statement->GetForeignKeys(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
 
 	return SQL_SUCCESS;
@@ -728,6 +746,8 @@ WD_PrimaryKeys(HSTMT hstmt,
 	ODBCStatement* statement = reinterpret_cast<ODBCStatement*>(hstmt);
 
 	MYLOG(0, "Entering\n");
+	RI_stale(statement);
+	SB_discard(statement);
 	statement->GetPrimaryKeys(nullptr, nullptr, nullptr);
 
 	return SQL_SUCCESS;
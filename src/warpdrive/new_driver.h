@@ -1,6 +1,8 @@
 /* File:			new_driver.h
  *
- * Description:		Entry point for creating a new instance of driver::odbcabstraction::Driver objects.
+ * Description:		Entry points implemented by the driver built on warpdrive: creating
+ *					driver::odbcabstraction::Driver objects, and the transaction
+ *					support that goes past the abstraction layer.
  *
  * Comments:		See "readme.txt" for copyright and license information.
  *
@@ -19,9 +21,32 @@ namespace odbcabstraction
 }
 }
 
+namespace ODBC
+{
+  class ODBCConnection;
+}
+
 /*
  * Create a new instance of the Driver object.
  */
 std::shared_ptr<driver::odbcabstraction::Driver> CreateDriver();
 
+/*
+ * Whether statements on 'conn' can run in Flight SQL transactions: the server says it supports
+ * them in its FLIGHT_SQL_SERVER_TRANSACTION SqlInfo, and the driver can send them.
+ */
+bool SupportsTransactions(ODBC::ODBCConnection *conn);
+
+/*
+ * Begin a transaction on 'conn'; the statements of the connection run in it until EndTransaction()
+ * ends it.  Returns false when the driver cannot, having done nothing.  Throws DriverException.
+ */
+bool BeginTransaction(ODBC::ODBCConnection *conn);
+
+/*
+ * Commit, or roll back, the transaction begun on 'conn'.  Throws DriverException, the transaction
+ * then still open.
+ */
+void EndTransaction(ODBC::ODBCConnection *conn, bool commit);
+
 #endif
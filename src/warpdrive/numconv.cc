@@ -0,0 +1,98 @@
+/*-------
+ * Module:			numconv.cc
+ *
+ * Description:		This module contains the formatting of integer and
+ *					floating point values as text, as numeric parameters
+ *					are sent to the server as literals.
+ *
+ *					Floating point values are written with the fewest
+ *					significant digits, up to 17, that read back as the
+ *					same value, so 0.1 goes to the server as 0.1 rather
+ *					than 0.10000000000000001.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "numconv.h"
+
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+size_t
+NC_format_int64(int64_t value, char *buf)
+{
+	return snprintf(buf, NC_INTEGER_BUFSIZE, FORMATI64, (SQLBIGINT) value);
+}
+
+size_t
+NC_format_uint64(uint64_t value, char *buf)
+{
+	return snprintf(buf, NC_INTEGER_BUFSIZE, FORMATI64U, (SQLUBIGINT) value);
+}
+
+/*
+ *	printf writes the decimal separator of the current locale; SQL wants
+ *	a period.  Only the first byte of the separator is looked at, as in
+ *	convert.cc.
+ */
+static void
+set_period(char *buf)
+{
+	char	point = localeconv()->decimal_point[0];
+	char	*p;
+
+	if ('.' != point && NULL != (p = strchr(buf, point)))
+		*p = '.';
+}
+
+static size_t
+format_special(double value, char *buf)
+{
+	const char *str = isnan(value) ? "NaN" : (value < 0 ? "-Infinity" : "Infinity");
+
+	strcpy(buf, str);
+	return strlen(str);
+}
+
+/* The shortest %g text of 'value' with at most 'max_digits' digits that reads back as 'value' */
+static size_t
+format_shortest(double value, int max_digits, bool single, char *buf)
+{
+	int	digits, exponent, len = 0;
+
+	if (!isfinite(value))
+		return format_special(value, buf);
+	for (digits = 1; digits <= max_digits; digits++)
+	{
+		len = snprintf(buf, NC_FLOATING_BUFSIZE, "%.*g", digits, value);
+		if (single ? strtof(buf, NULL) == (float) value : strtod(buf, NULL) == value)
+			break;
+	}
+	/* 100 rather than 1e+02: %g goes to exponents past the digits asked for */
+	exponent = 0 != value ? (int) floor(log10(fabs(value))) : 0;
+	if (exponent >= digits && exponent < max_digits)
+		len = snprintf(buf, NC_FLOATING_BUFSIZE, "%.*g", exponent + 1, value);
+	set_period(buf);
+	return len;
+}
+
+size_t
+NC_format_double(double value, char *buf)
+{
+	return format_shortest(value, 17, false, buf);
+}
+
+size_t
+NC_format_float(float value, char *buf)
+{
+	return format_shortest(value, 9, true, buf);
+}
@@ -0,0 +1,32 @@
+/* File:			numconv.h
+ *
+ * Description:		See "numconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __NUMCONV_H__
+#define __NUMCONV_H__
+
+#include "wdodbc.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Buffer sizes large enough for any value produced by the NC_format_xxx functions */
+#define	NC_INTEGER_BUFSIZE	24
+#define	NC_FLOATING_BUFSIZE	32
+
+/*
+ *	Scalar formatters.  They write a C string into 'buf' and return its
+ *	length.  Floating point values use the shortest representation that
+ *	round-trips to the same value, in printf's %g notation with a period
+ *	for the decimal point whatever the locale.
+ */
+size_t	NC_format_int64(int64_t value, char *buf);
+size_t	NC_format_uint64(uint64_t value, char *buf);
+size_t	NC_format_double(double value, char *buf);
+size_t	NC_format_float(float value, char *buf);
+
+#endif /* __NUMCONV_H__ */
@@ -41,6 +41,7 @@
 #include "statement.h"
 #include "qresult.h"
 #include "loadlib.h"
+#include "asyncexec.h"
 
 #include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/odbc_impl/ODBCDescriptor.h>
@@ -129,11 +130,13 @@ SQLConnect(HDBC ConnectionHandle,
 		   SQLCHAR *UserName, SQLSMALLINT NameLength2,
 		   SQLCHAR *Authentication, SQLSMALLINT NameLength3)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-        return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() -> SQLRETURN {
-          MYLOG(0, "Entering\n");
-          return WD_Connect(ConnectionHandle, ServerName, NameLength1, UserName,
-                           NameLength2, Authentication, NameLength3);
+        return AE_run(SQL_HANDLE_DBC, ConnectionHandle, SQL_API_SQLCONNECT, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() -> SQLRETURN {
+            MYLOG(0, "Entering\n");
+            return WD_Connect(ConnectionHandle, ServerName, NameLength1, UserName,
+                             NameLength2, Authentication, NameLength3);
+                });
               });
 }
 
@@ -148,12 +151,14 @@ SQLDriverConnect(HDBC hdbc,
 				 SQLSMALLINT * pcbConnStrOut,
 				 SQLUSMALLINT fDriverCompletion)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-        return ODBCConnection::ExecuteWithDiagnostics(hdbc, rc, [&]() -> SQLRETURN {
+        return AE_run(SQL_HANDLE_DBC, hdbc, SQL_API_SQLDRIVERCONNECT, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCConnection::ExecuteWithDiagnostics(hdbc, rc, [&]() -> SQLRETURN {
 
-          MYLOG(0, "Entering\n");
-          return WD_DriverConnect(hdbc, hwnd, szConnStrIn, cbConnStrIn, szConnStrOut,
-                                 cbConnStrOutMax, pcbConnStrOut, fDriverCompletion);
+            MYLOG(0, "Entering\n");
+            return WD_DriverConnect(hdbc, hwnd, szConnStrIn, cbConnStrIn, szConnStrOut,
+                                   cbConnStrOutMax, pcbConnStrOut, fDriverCompletion);
+                });
               });
 }
 
@@ -215,10 +220,12 @@ WD_EXPORT_SYMBOL
 RETCODE		SQL_API
 SQLDisconnect(HDBC ConnectionHandle)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-  return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() -> SQLRETURN {
-    MYLOG(0, "Entering for %p\n", ConnectionHandle);
-    return WD_Disconnect(ConnectionHandle);
+  return AE_run(SQL_HANDLE_DBC, ConnectionHandle, SQL_API_SQLDISCONNECT, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() -> SQLRETURN {
+      MYLOG(0, "Entering for %p\n", ConnectionHandle);
+      return WD_Disconnect(ConnectionHandle);
+          });
         });
 }
 
@@ -228,13 +235,15 @@ RETCODE		SQL_API
 SQLExecDirect(HSTMT StatementHandle,
 			  SQLCHAR *StatementText, SQLINTEGER TextLength)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR func = "SQLExecDirect";
-        return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-          UWORD flag = 0;
+        return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLEXECDIRECT, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+            UWORD flag = 0;
 
-          MYLOG(0, "Entering\n");
-          return WD_ExecDirect(StatementHandle, StatementText, TextLength, flag);
+            MYLOG(0, "Entering\n");
+            return WD_ExecDirect(StatementHandle, StatementText, TextLength, flag);
+                });
               });
 }
 #endif /* UNICODE_SUPPORTXX */
@@ -243,13 +252,15 @@ WD_EXPORT_SYMBOL
 RETCODE		SQL_API
 SQLExecute(HSTMT StatementHandle)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR func = "SQLExecute";
-        return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-          UWORD flag = 0;
+        return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLEXECUTE, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+            UWORD flag = 0;
 
-          MYLOG(0, "Entering\n");
-          return WD_Execute(StatementHandle, flag);
+            MYLOG(0, "Entering\n");
+            return WD_Execute(StatementHandle, flag);
+                });
               });
 }
 
@@ -257,9 +268,11 @@ WD_EXPORT_SYMBOL
 RETCODE		SQL_API
 SQLFetch(HSTMT StatementHandle)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-  return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-    return WD_Fetch(StatementHandle);
+  return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLFETCH, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+      return WD_Fetch(StatementHandle);
+    });
   });
 }
 
@@ -391,11 +404,13 @@ RETCODE		SQL_API
 SQLPrepare(HSTMT StatementHandle,
 		   SQLCHAR *StatementText, SQLINTEGER TextLength)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR func = "SQLPrepare";
-        return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-          MYLOG(0, "Entering\n");
-          return WD_Prepare(StatementHandle, StatementText, TextLength);
+        return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLPREPARE, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+            MYLOG(0, "Entering\n");
+            return WD_Prepare(StatementHandle, StatementText, TextLength);
+                });
               });
 }
 #endif /* UNICODE_SUPPORTXX */
@@ -833,10 +848,13 @@ WD_EXPORT_SYMBOL
 RETCODE		SQL_API
 SQLMoreResults(HSTMT hstmt)
 {
-	RETCODE	ret = SQL_NO_DATA;
-
-	MYLOG(0, "Entering\n");
-	return ret;
+  return AE_run(SQL_HANDLE_STMT, hstmt, SQL_API_SQLMORERESULTS, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCStatement::ExecuteWithDiagnostics(hstmt, rc, [&]() -> SQLRETURN {
+      MYLOG(0, "Entering\n");
+      return WD_MoreResults(hstmt);
+    });
+  });
 }
 
 #ifndef	UNICODE_SUPPORTXX
@@ -1177,19 +1195,9 @@ SQLBindParameter(HSTMT hstmt,
 				 SQLLEN *pcbValue)
 {
   SQLRETURN rc = SQL_SUCCESS;
-	RETCODE	ret;
         return ODBCStatement::ExecuteWithDiagnostics(hstmt, rc, [&]() -> SQLRETURN {
-          throw DriverException("Unsupported function.", "HYC00");
-          StatementClass *stmt = (StatementClass *)hstmt;
-
           MYLOG(0, "Entering\n");
-          ENTER_STMT_CS(stmt);
-          SC_clear_error(stmt);
-          StartRollbackState(stmt);
-          ret = WD_BindParameter(hstmt, ipar, fParamType, fCType, fSqlType, cbColDef,
+          return WD_BindParameter(hstmt, ipar, fParamType, fCType, fSqlType, cbColDef,
                                  ibScale, rgbValue, cbValueMax, pcbValue);
-          ret = DiscardStatementSvp(stmt, ret, FALSE);
-          LEAVE_STMT_CS(stmt);
-          return ret;
               });
 }
@@ -32,6 +32,10 @@
 #include "connection.h"
 #include "statement.h"
 #include "wdapifunc.h"
+#include "asyncexec.h"
+#include "bulkops.h"
+#include "stmtbatch.h"
+#include "transact.h"
 
 #include <odbcabstraction/exceptions.h>
 #include <odbcabstraction/odbc_impl/ODBCConnection.h>
@@ -98,9 +102,7 @@ SQLBindParam(HSTMT StatementHandle,
 {
   SQLRETURN rc = SQL_SUCCESS;
   return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-    throw DriverException("Unsupported function", "HYC00");
     RETCODE ret;
-    StatementClass *stmt = (StatementClass *)StatementHandle;
     int BufferLength = 512; /* Is it OK ? */
 
     MYLOG(0, "Entering\n");
@@ -123,6 +125,7 @@ SQLCloseCursor(HSTMT StatementHandle)
 
     MYLOG(0, "Entering\n");
 
+    SB_discard(stmt);
     stmt->closeCursor(false);
     return SQL_SUCCESS;
         });
@@ -194,14 +197,7 @@ SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle,
           });
 		case SQL_HANDLE_DBC:
           return ODBCConnection::ExecuteWithDiagnostics(Handle, rc, [&]() -> SQLRETURN {
-            ODBC::ODBCConnection *conn = reinterpret_cast<ODBC::ODBCConnection *>(Handle);
-            SQLUINTEGER value;
-            conn->GetConnectAttr(SQL_ATTR_AUTOCOMMIT, &value, sizeof(SQLUINTEGER), nullptr, false);
-            if (value != SQL_AUTOCOMMIT_ON) {
-                throw DriverException("Unsupported function", "HYC00");
-            } else {
-                return SQL_SUCCESS;
-            }
+            return TX_end(reinterpret_cast<ODBC::ODBCConnection *>(Handle), CompletionType);
           });
 		default:
 			return SQL_ERROR;
@@ -215,14 +211,16 @@ RETCODE		SQL_API
 SQLFetchScroll(HSTMT StatementHandle,
 			   SQLSMALLINT FetchOrientation, SQLLEN FetchOffset)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-  return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-    if (FetchOrientation != SQL_FETCH_NEXT) {
-      throw DriverException("Fetch type unsupported", "HY106");
-    }
+  return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLFETCHSCROLL, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+      if (FetchOrientation != SQL_FETCH_NEXT) {
+        throw DriverException("Fetch type unsupported", "HY106");
+      }
 
-    RETCODE result = WD_Fetch(StatementHandle);
-    return result;
+      RETCODE result = WD_Fetch(StatementHandle);
+      return result;
+    });
   });
 }
 
@@ -253,6 +251,27 @@ SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle)
 	}
 	return ret;
 }
+
+/*	ODBC 3.8: the result of an asynchronous function after its notification */
+WD_EXPORT_SYMBOL
+RETCODE		SQL_API
+SQLCompleteAsync(SQLSMALLINT HandleType, SQLHANDLE Handle,
+				 RETCODE *AsyncRetCodePtr)
+{
+	MYLOG(0, "Entering\n");
+
+    // Do not use ExecuteWithDiagnostics, it would clear the diagnostics
+    // the asynchronous function left on the handle.
+    if (!Handle)
+        return SQL_INVALID_HANDLE;
+    switch (HandleType)
+	{
+		case SQL_HANDLE_DBC:
+		case SQL_HANDLE_STMT:
+            return AE_complete(HandleType, Handle, AsyncRetCodePtr);
+	}
+	return SQL_INVALID_HANDLE;
+}
 		
 #ifndef	UNICODE_SUPPORTXX
 /*	new function */
@@ -537,6 +556,9 @@ SQLSetStmtAttr(HSTMT StatementHandle,
 }
 #endif /* UNICODE_SUPPORTXX */
 
+#ifndef	SQL_API_SQLCOMPLETEASYNC
+#define	SQL_API_SQLCOMPLETEASYNC	1551
+#endif
 #define SQL_FUNC_ESET(pfExists, uwAPI) \
 		(*(((UWORD*) (pfExists)) + ((uwAPI) >> 4)) \
 			|= (1 << ((uwAPI) & 0x000F)) \
@@ -545,24 +567,15 @@ SQLSetStmtAttr(HSTMT StatementHandle,
 RETCODE	SQL_API
 SQLBulkOperations(HSTMT hstmt, SQLSMALLINT operation)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-  return ODBCStatement::ExecuteWithDiagnostics(hstmt, rc, [&]() -> SQLRETURN {
-    RETCODE ret;
-    throw DriverException("Unsupported function", "HYC00");
-    StatementClass *stmt = (StatementClass *)hstmt;
-
-    if (SC_connection_lost_check(stmt, __FUNCTION__))
-      return SQL_ERROR;
-
-    ENTER_STMT_CS(stmt);
-    MYLOG(0, "Entering Handle=%p %d\n", hstmt, operation);
-    SC_clear_error(stmt);
-    StartRollbackState(stmt);
-    ret = WD_BulkOperations(hstmt, operation);
-    ret = DiscardStatementSvp(stmt, ret, FALSE);
-    LEAVE_STMT_CS(stmt);
-    return SQL_ERROR;
-        });
+  return AE_run(SQL_HANDLE_STMT, hstmt, SQL_API_SQLBULKOPERATIONS, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCStatement::ExecuteWithDiagnostics(hstmt, rc, [&]() -> SQLRETURN {
+      MYLOG(0, "Entering Handle=%p %d\n", hstmt, operation);
+      if (SQL_ADD != operation)
+        throw DriverException("Optional feature not implemented", "HYC00");
+      return BO_add(reinterpret_cast<ODBCStatement*>(hstmt));
+    });
+  });
 }
 
 }
@@ -669,7 +682,8 @@ WD_GetFunctions30(HDBC hdbc, SQLUSMALLINT fFunction, SQLUSMALLINT FAR* pfExists)
     SQL_FUNC_ESET(pfExists, SQL_API_SQLSETENVATTR);		/* 1019 */
     SQL_FUNC_ESET(pfExists, SQL_API_SQLSETSTMTATTR);	/* 1020 */
     SQL_FUNC_ESET(pfExists, SQL_API_SQLFETCHSCROLL);	/* 1021 */
-    //SQL_FUNC_ESET(pfExists, SQL_API_SQLBULKOPERATIONS);	/* 24 */
+    SQL_FUNC_ESET(pfExists, SQL_API_SQLCOMPLETEASYNC);	/* 1551 */
+    SQL_FUNC_ESET(pfExists, SQL_API_SQLBULKOPERATIONS);	/* 24 */
 
     return SQL_SUCCESS;
 }
@@ -28,6 +28,8 @@
 #include "wdapifunc.h"
 #include "connection.h"
 #include "statement.h"
+#include "resinfo.h"
+#include "asyncexec.h"
 
 #include <odbcabstraction/odbc_impl/ODBCConnection.h>
 #include <odbcabstraction/odbc_impl/ODBCStatement.h>
@@ -69,16 +71,18 @@ SQLConnectW(HDBC ConnectionHandle,
 			SQLWCHAR *UserName, SQLSMALLINT NameLength2,
 			SQLWCHAR *Authentication, SQLSMALLINT NameLength3)
 {
-  SQLRETURN rc = SQL_SUCCESS;
-  return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() {
-    c_ptr svName, usName, auth;
-    SQLLEN nmlen1, nmlen2, nmlen3;
-    svName.reset(wcs_to_utf8(ServerName, NameLength1, &nmlen1, FALSE));
-    usName.reset(wcs_to_utf8(UserName, NameLength2, &nmlen2, FALSE));
-    auth.reset(wcs_to_utf8(Authentication, NameLength3, &nmlen3, FALSE));
-    return WD_Connect(ConnectionHandle, (SQLCHAR *)svName.get(), (SQLSMALLINT)nmlen1,
-                     (SQLCHAR *)usName.get(), (SQLSMALLINT)nmlen2, (SQLCHAR *)auth.get(),
-                     (SQLSMALLINT)nmlen3);
+  return AE_run(SQL_HANDLE_DBC, ConnectionHandle, SQL_API_SQLCONNECT, [=]() -> SQLRETURN {
+    SQLRETURN rc = SQL_SUCCESS;
+    return ODBCConnection::ExecuteWithDiagnostics(ConnectionHandle, rc, [&]() {
+      c_ptr svName, usName, auth;
+      SQLLEN nmlen1, nmlen2, nmlen3;
+      svName.reset(wcs_to_utf8(ServerName, NameLength1, &nmlen1, FALSE));
+      usName.reset(wcs_to_utf8(UserName, NameLength2, &nmlen2, FALSE));
+      auth.reset(wcs_to_utf8(Authentication, NameLength3, &nmlen3, FALSE));
+      return WD_Connect(ConnectionHandle, (SQLCHAR *)svName.get(), (SQLSMALLINT)nmlen1,
+                       (SQLCHAR *)usName.get(), (SQLSMALLINT)nmlen2, (SQLCHAR *)auth.get(),
+                       (SQLSMALLINT)nmlen3);
+          });
         });
 }
 
@@ -93,8 +97,9 @@ SQLDriverConnectW(HDBC hdbc,
 				  SQLSMALLINT *pcbConnStrOut,
 				  SQLUSMALLINT fDriverCompletion)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR func = "SQLDriverConnectW";
+        return AE_run(SQL_HANDLE_DBC, hdbc, SQL_API_SQLDRIVERCONNECT, [=]() -> SQLRETURN {
+        SQLRETURN rc = SQL_SUCCESS;
         return ODBCConnection::ExecuteWithDiagnostics(hdbc, rc, [&]() {
           c_ptr szIn, szOut;
           SQLSMALLINT maxlen, obuflen = 0;
@@ -139,6 +144,7 @@ SQLDriverConnectW(HDBC hdbc,
           }
           return ret;
         });
+        });
 }
 
 WD_EXPORT_SYMBOL
@@ -205,42 +211,26 @@ SQLDescribeColW(HSTMT StatementHandle,
 	CSTR func = "SQLDescribeColW";
         return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
           RETCODE ret;
-          SQLSMALLINT buflen, nmlen;
-          c_ptr clName;
-
-          buflen = 0;
-          if (BufferLength > 0)
-            buflen = BufferLength * 3;
-          else if (NameLength)
-            buflen = 32;
-          if (buflen > 0)
-            clName.reset(static_cast<char *>(malloc(buflen)));
-          for (;; buflen = nmlen + 1,
-                  clName.reallocate(buflen)) {
-            if (!clName) {
-              throw std::bad_alloc();
-            }
-            ret = WD_DescribeCol(StatementHandle, ColumnNumber, (SQLCHAR *)clName.get(),
-                                 buflen, &nmlen, DataType, ColumnSize, DecimalDigits,
-                                 Nullable);
-            if (SQL_SUCCESS_WITH_INFO != ret || nmlen < buflen)
-                break;
-            else
-                // Get rid of any internally-generated truncation warnings.
-                ODBCStatement::of(StatementHandle)->GetDiagnostics().Clear();
-          }
-          if (SQL_SUCCEEDED(ret)) {
-            SQLLEN nmcount = nmlen;
-
-            if (nmlen < buflen)
-              nmcount = utf8_to_ucs2(clName.get(), nmlen, ColumnName, BufferLength);
-            if (SQL_SUCCESS == ret && BufferLength > 0 && nmcount > BufferLength) {
+          const ResultColumn *column;
+
+          ret = WD_DescribeCol(StatementHandle, ColumnNumber, NULL, 0, NULL,
+                               DataType, ColumnSize, DecimalDigits, Nullable);
+          if (!SQL_SUCCEEDED(ret))
+            return ret;
+          /* the name was converted when the result was described */
+          column = RI_column(ODBCStatement::of(StatementHandle), ColumnNumber);
+          if (ColumnName && BufferLength > 0) {
+            size_t count = column->wname_len < (size_t) BufferLength ? column->wname_len : BufferLength - 1;
+
+            memcpy(ColumnName, column->wname, count * WCLEN);
+            ColumnName[count] = 0;
+            if (column->wname_len >= (size_t) BufferLength) {
               ret = SQL_SUCCESS_WITH_INFO;
               ODBCStatement::of(StatementHandle)->GetDiagnostics().AddTruncationWarning();
             }
-            if (NameLength)
-              *NameLength = (SQLSMALLINT)nmcount;
           }
+          if (NameLength)
+            *NameLength = (SQLSMALLINT) column->wname_len;
           return ret;
               });
 }
@@ -250,17 +240,20 @@ RETCODE  SQL_API
 SQLExecDirectW(HSTMT StatementHandle,
 			   SQLWCHAR *StatementText, SQLINTEGER TextLength)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR	func = "SQLExecDirectW";
-	c_ptr	stxt;
-	SQLLEN	slen;
-	UWORD	flag = 0;
 
 	MYLOG(0, "Entering\n");
-        return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-          stxt.reset(wcs_to_utf8(StatementText, TextLength, &slen, FALSE));
-          return WD_ExecDirect(StatementHandle, (SQLCHAR *)stxt.get(),
-                              (SQLINTEGER)slen, flag);
+        return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLEXECDIRECT, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+            c_ptr	stxt;
+            SQLLEN	slen;
+            UWORD	flag = 0;
+
+            stxt.reset(wcs_to_utf8(StatementText, TextLength, &slen, FALSE));
+            return WD_ExecDirect(StatementHandle, (SQLCHAR *)stxt.get(),
+                                (SQLINTEGER)slen, flag);
+    });
   });
 }
 
@@ -333,15 +326,17 @@ RETCODE  SQL_API
 SQLPrepareW(HSTMT StatementHandle,
 			SQLWCHAR *StatementText, SQLINTEGER TextLength)
 {
-  SQLRETURN rc = SQL_SUCCESS;
 	CSTR func = "SQLPrepareW";
-        return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
-          c_ptr stxt;
-          SQLLEN slen;
-
-          MYLOG(0, "Entering\n");
-          stxt.reset(wcs_to_utf8(StatementText, TextLength, &slen, FALSE));
-          return WD_Prepare(StatementHandle, (SQLCHAR *)stxt.get(), (SQLINTEGER)slen);
+        return AE_run(SQL_HANDLE_STMT, StatementHandle, SQL_API_SQLPREPARE, [=]() -> SQLRETURN {
+          SQLRETURN rc = SQL_SUCCESS;
+          return ODBCStatement::ExecuteWithDiagnostics(StatementHandle, rc, [&]() -> SQLRETURN {
+            c_ptr stxt;
+            SQLLEN slen;
+
+            MYLOG(0, "Entering\n");
+            stxt.reset(wcs_to_utf8(StatementText, TextLength, &slen, FALSE));
+            return WD_Prepare(StatementHandle, (SQLCHAR *)stxt.get(), (SQLINTEGER)slen);
+                });
               });
 }
 
@@ -0,0 +1,444 @@
+/*-------
+ * Module:			odbcescape.cc
+ *
+ * Description:		This module contains the rewriting of the ODBC escape
+ *					sequences of statement texts: {fn ...}, {d ...},
+ *					{t ...}, {ts ...}, {oj ...}, {call ...}, {escape ...},
+ *					{interval ...} and {guid ...}.
+ *
+ *					The text is read once, skipping string literals,
+ *					quoted identifiers and comments; an escape is rewritten
+ *					once those nested in it are.  Scalar functions the
+ *					server knows under another name, or in another form,
+ *					are mapped, the others kept as they are.  A text
+ *					without a brace is not looked at further.  A procedure
+ *					call returning a value, {? = call ...}, is rejected:
+ *					the server's CALL has no return value to bind.
+ *
+ * Classes:			none
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "odbcescape.h"
+#include "extension.h"
+#include "sqllexer.h"
+#include "mylog.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCStatement;
+
+/*
+ *	Scalar functions of {fn ...} the server has in another form.  As in
+ *	convert.cc, an ODBC name beginning with % and a digit matches only
+ *	that number of arguments; $n stands for argument n and $* for all of
+ *	them.
+ */
+static const struct
+{
+	const char *odbc_name;
+	const char *native;
+} fn_map[] = {
+	{"CEILING", "CEIL($*)"},
+	{"CHAR", "CHR($*)"},
+	{"CURDATE", "CURRENT_DATE"},
+	{"CURTIME", "CURRENT_TIME"},
+	{"%1DAYOFMONTH", "EXTRACT(DAY FROM $1)"},
+	{"%1DAYOFWEEK", "EXTRACT(DOW FROM $1)"},
+	{"%1DAYOFYEAR", "EXTRACT(DOY FROM $1)"},
+	{"%1HOUR", "EXTRACT(HOUR FROM $1)"},
+	{"IFNULL", "COALESCE($*)"},
+	{"LCASE", "LOWER($*)"},
+	{"%1LENGTH", "CHAR_LENGTH(RTRIM($1))"},
+	{"%1LOG", "LN($1)"},
+	{"%1MINUTE", "EXTRACT(MINUTE FROM $1)"},
+	{"%1MONTH", "EXTRACT(MONTH FROM $1)"},
+	{"NOW", "CURRENT_TIMESTAMP"},
+	{"%1QUARTER", "EXTRACT(QUARTER FROM $1)"},
+	{"%0RAND", "RANDOM()"},
+	{"%1SECOND", "EXTRACT(SECOND FROM $1)"},
+	{"%1SPACE", "REPEAT(' ', $1)"},
+	{"UCASE", "UPPER($*)"},
+	{"USER", "CURRENT_USER"},
+	{"%1WEEK", "EXTRACT(WEEK FROM $1)"},
+	{"%1YEAR", "EXTRACT(YEAR FROM $1)"},
+	{0, 0}
+};
+
+/* The server types of the SQL_ type names of {fn CONVERT(value, type)} */
+static const struct
+{
+	const char *odbc_name;
+	const char *native;
+} convert_map[] = {
+	{"SQL_BIGINT", "BIGINT"},
+	{"SQL_BINARY", "VARBINARY"},
+	{"SQL_BIT", "BOOLEAN"},
+	{"SQL_CHAR", "VARCHAR"},
+	{"SQL_DATE", "DATE"},
+	{"SQL_DECIMAL", "DECIMAL"},
+	{"SQL_DOUBLE", "DOUBLE"},
+	{"SQL_FLOAT", "DOUBLE"},
+	{"SQL_INTEGER", "INTEGER"},
+	{"SQL_LONGVARBINARY", "VARBINARY"},
+	{"SQL_LONGVARCHAR", "VARCHAR"},
+	{"SQL_NUMERIC", "DECIMAL"},
+	{"SQL_REAL", "FLOAT"},
+	{"SQL_SMALLINT", "SMALLINT"},
+	{"SQL_TIME", "TIME"},
+	{"SQL_TIMESTAMP", "TIMESTAMP"},
+	{"SQL_TINYINT", "TINYINT"},
+	{"SQL_TYPE_DATE", "DATE"},
+	{"SQL_TYPE_TIME", "TIME"},
+	{"SQL_TYPE_TIMESTAMP", "TIMESTAMP"},
+	{"SQL_VARBINARY", "VARBINARY"},
+	{"SQL_VARCHAR", "VARCHAR"},
+	{"SQL_WCHAR", "VARCHAR"},
+	{"SQL_WLONGVARCHAR", "VARCHAR"},
+	{"SQL_WVARCHAR", "VARCHAR"},
+	{0, 0}
+};
+
+typedef struct
+{
+	const char	*sql;
+	size_t		len;
+	size_t		pos;
+	BOOL		broken;		/* an escape is not closed, or nested too deep */
+} Scan;
+
+static BOOL	rewrite_span(Scan *scan, std::string &out, int depth);
+
+static std::string
+trimmed(const char *s, size_t len)
+{
+	size_t	b = 0;
+
+	while (b < len && isspace((UCHAR) s[b]))
+		b++;
+	while (len > b && isspace((UCHAR) s[len - 1]))
+		len--;
+	return std::string(s + b, len - b);
+}
+
+/*
+ *	Split the argument list of 'body' opening at 'open' at its commas
+ *	outside parentheses, literals and comments.  Returns the index of its
+ *	closing parenthesis, 0 when there is none.
+ */
+static size_t
+split_arguments(const std::string &body, size_t open, std::vector<std::string> &args)
+{
+	const char	*s = body.data();
+	size_t		len = body.size(), i = open + 1, start = i, next;
+	int		nesting = 0;
+
+	while (i < len)
+	{
+		if (next = LX_skip(s, len, i), next != i)
+		{
+			i = next;
+			continue;
+		}
+		if ('(' == s[i])
+			nesting++;
+		else if (')' == s[i] && nesting > 0)
+			nesting--;
+		else if (')' == s[i] || (',' == s[i] && 0 == nesting))
+		{
+			args.push_back(trimmed(s + start, i - start));
+			if (')' == s[i])
+			{
+				if (1 == args.size() && args[0].empty())
+					args.clear();
+				return i;
+			}
+			start = i + 1;
+		}
+		i++;
+	}
+	return 0;
+}
+
+/* 'native' with its $n and $* made the arguments; FALSE when it wants more of them */
+static BOOL
+expand(const char *native, const std::vector<std::string> &args, std::string &out)
+{
+	std::string	text;
+	const char	*p;
+	size_t		k;
+
+	for (p = native; *p; p++)
+	{
+		if ('$' == p[0] && '*' == p[1])
+		{
+			for (k = 0; k < args.size(); k++)
+			{
+				if (k > 0)
+					text += ", ";
+				text += args[k];
+			}
+			p++;
+		}
+		else if ('$' == p[0] && isdigit((UCHAR) p[1]))
+		{
+			k = p[1] - '1';
+			if (k >= args.size())
+				return FALSE;
+			text += args[k];
+			p++;
+		}
+		else
+			text += *p;
+	}
+	out += text;
+	return TRUE;
+}
+
+/* Rewrite the scalar function call 'body' of {fn ...} */
+static void
+translate_function(const std::string &body, std::string &out)
+{
+	std::vector<std::string>	args;
+	std::string	name;
+	size_t		i = 0, open, close = 0, k;
+	const char	*p;
+
+	while (i < body.size() && (isalnum((UCHAR) body[i]) || '_' == body[i]))
+		i++;
+	name = body.substr(0, i);
+	for (open = i; open < body.size() && isspace((UCHAR) body[open]); open++)
+		;
+	if (open < body.size())
+	{
+		if ('(' != body[open] || 0 == (close = split_arguments(body, open, args)))
+		{
+			out += body;
+			return;
+		}
+	}
+
+	if (0 == stricmp(name.c_str(), "CONVERT") && 2 == args.size())
+	{
+		for (k = 0; convert_map[k].odbc_name; k++)
+			if (0 == stricmp(convert_map[k].odbc_name, args[1].c_str()))
+			{
+				out += "CAST(" + args[0] + " AS " + convert_map[k].native + ")";
+				out += body.substr(close + 1);
+				return;
+			}
+	}
+	else if ((0 == stricmp(name.c_str(), "TIMESTAMPADD") ||
+		  0 == stricmp(name.c_str(), "TIMESTAMPDIFF")) &&
+		 args.size() > 0 && 0 == strnicmp(args[0].c_str(), "SQL_TSI_", 8))
+	{
+		/* the server counts fractions of a second in microseconds */
+		if (0 == stricmp(args[0].c_str() + 8, "FRAC_SECOND"))
+			out += name + "(MICROSECOND";
+		else
+			out += name + "(" + args[0].substr(8);
+		for (k = 1; k < args.size(); k++)
+			out += ", " + args[k];
+		out += ")";
+		out += body.substr(close + 1);
+		return;
+	}
+
+	for (k = 0; (p = fn_map[k].odbc_name) != NULL; k++)
+	{
+		if ('%' == p[0])
+		{
+			if ((size_t) (p[1] - '0') != args.size())
+				continue;
+			p += 2;
+		}
+		if (0 == stricmp(p, name.c_str()) && expand(fn_map[k].native, args, out))
+		{
+			/* a name without arguments may still be followed by () */
+			if (close > 0)
+				out += body.substr(close + 1);
+			return;
+		}
+	}
+	out += body;
+}
+
+/* Rewrite the escape whose keyword is 'len' bytes at 'keyword' and whose rewritten text is 'body' */
+static BOOL
+translate(const char *keyword, size_t len, const std::string &body, std::string &out)
+{
+	static const struct
+	{
+		const char *keyword;
+		const char *prefix;
+	} prefixes[] = {
+		{"d", "DATE "},
+		{"t", "TIME "},
+		{"ts", "TIMESTAMP "},
+		{"call", "CALL "},
+		{"escape", "ESCAPE "},
+		{"interval", "INTERVAL "},
+		{"oj", ""},
+		{"guid", ""},
+		{0, 0}
+	};
+	std::string	text = trimmed(body.data(), body.size());
+	int		k;
+
+	if (2 == len && 0 == strnicmp(keyword, "fn", 2))
+	{
+		translate_function(text, out);
+		return TRUE;
+	}
+	for (k = 0; prefixes[k].keyword; k++)
+		if (strlen(prefixes[k].keyword) == len && 0 == strnicmp(keyword, prefixes[k].keyword, len))
+		{
+			out += prefixes[k].prefix;
+			out += text;
+			return TRUE;
+		}
+	return FALSE;
+}
+
+/* Rewrite the escape opening at the brace at scan->pos into 'out' */
+static BOOL
+rewrite_escape(Scan *scan, std::string &out, int depth)
+{
+	size_t		open = scan->pos, keyword, end;
+	std::string	body;
+
+	for (keyword = open + 1; keyword < scan->len && isspace((UCHAR) scan->sql[keyword]); keyword++)
+		;
+	for (end = keyword; end < scan->len && isalpha((UCHAR) scan->sql[end]); end++)
+		;
+	if (end == keyword && end < scan->len && '?' == scan->sql[end])
+		throw DriverException("Procedure calls returning a value are not supported", "HYC00");
+	scan->pos = end;
+	if (!rewrite_span(scan, body, depth))
+	{
+		scan->broken = TRUE;
+		return FALSE;
+	}
+	if (!translate(scan->sql + keyword, end - keyword, body, out))
+	{
+		/* not an escape the driver knows */
+		out.append(scan->sql + open, end - open);
+		out += body;
+		out += '}';
+	}
+	return TRUE;
+}
+
+/*
+ *	Copy the text from scan->pos into 'out', rewriting the escapes in it,
+ *	up to the end or, inside an escape, its closing brace.  TRUE when a
+ *	brace closed it.
+ */
+static BOOL
+rewrite_span(Scan *scan, std::string &out, int depth)
+{
+	size_t	i = scan->pos, start = i, next;
+
+	while (i < scan->len && !scan->broken)
+	{
+		if (next = LX_skip(scan->sql, scan->len, i), next != i)
+		{
+			i = next;
+			continue;
+		}
+		if ('}' == scan->sql[i] && depth > 0)
+		{
+			out.append(scan->sql + start, i - start);
+			scan->pos = i + 1;
+			return TRUE;
+		}
+		if ('{' == scan->sql[i])
+		{
+			out.append(scan->sql + start, i - start);
+			if (depth >= ES_MAX_DEPTH)
+			{
+				scan->broken = TRUE;
+				return FALSE;
+			}
+			scan->pos = i;
+			if (!rewrite_escape(scan, out, depth + 1))
+				return FALSE;
+			i = start = scan->pos;
+			continue;
+		}
+		i++;
+	}
+	out.append(scan->sql + start, i - start);
+	scan->pos = i;
+	return FALSE;
+}
+
+/* 'query' rewritten */
+static void
+rewrite(std::string &query)
+{
+	std::string	out;
+	Scan		scan;
+
+	if (!memchr(query.data(), '{', query.size()))
+		return;
+	scan.sql = query.data();
+	scan.len = query.size();
+	scan.pos = 0;
+	scan.broken = FALSE;
+	out.reserve(query.size());
+	rewrite_span(&scan, out, 0);
+	if (scan.broken)
+	{
+		MYLOG(0, "escapes not well formed, the text is left as it is\n");
+		out = query;
+	}
+	else
+		MYLOG(DETAIL_LOG_LEVEL, "rewritten: %s\n", out.c_str());
+	query.swap(out);
+}
+
+void
+ES_translate(ODBCStatement *stmt, std::string &query)
+{
+	if (EX_stmt(stmt)->noscan)
+		return;
+	rewrite(query);
+}
+
+void
+ES_native(std::string &query)
+{
+	rewrite(query);
+}
+
+BOOL
+ES_set_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	if (SQL_ATTR_NOSCAN != attr)
+		return FALSE;
+	EX_stmt(stmt)->noscan = SQL_NOSCAN_ON == (SQLULEN) value;
+	return TRUE;
+}
+
+BOOL
+ES_get_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	if (SQL_ATTR_NOSCAN != attr)
+		return FALSE;
+	if (value)
+		*((SQLULEN *) value) = EX_stmt(stmt)->noscan ? SQL_NOSCAN_ON : SQL_NOSCAN_OFF;
+	return TRUE;
+}
@@ -0,0 +1,43 @@
+/* File:			odbcescape.h
+ *
+ * Description:		See "odbcescape.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __ODBCESCAPE_H__
+#define __ODBCESCAPE_H__
+
+#include "wdodbc.h"
+
+#include <string>
+
+namespace ODBC
+{
+  class ODBCStatement;
+}
+
+/* Deepest nesting of escapes rewritten; a text nesting deeper is left as it is */
+#define	ES_MAX_DEPTH		64
+
+/*
+ *	SQLPrepare and SQLExecDirect of 'query' on 'stmt': its ODBC escape
+ *	sequences are rewritten in the server's syntax, unless
+ *	SQL_ATTR_NOSCAN is on.  A text with no escape, or one not well
+ *	formed, is left as it is.  Throws DriverException for a procedure
+ *	call returning a value.
+ */
+void	ES_translate(ODBC::ODBCStatement *stmt, std::string &query);
+
+/* SQLNativeSql: the same, whatever SQL_ATTR_NOSCAN */
+void	ES_native(std::string &query);
+
+/*
+ *	SQLSetStmtAttr and SQLGetStmtAttr of SQL_ATTR_NOSCAN.  Return FALSE,
+ *	doing nothing, for any other attribute.
+ */
+BOOL	ES_set_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+BOOL	ES_get_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+
+#endif /* __ODBCESCAPE_H__ */
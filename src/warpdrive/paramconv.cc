@@ -0,0 +1,1994 @@
+/*-------
+ * Module:			paramconv.cc
+ *
+ * Description:		This module contains the conversion of bound parameter
+ *					buffers into an Arrow record batch, the scanning of
+ *					parameter markers and the rendering of parameter values
+ *					as SQL literals.
+ *
+ *					Parameter sets are converted one at a time, every
+ *					parameter first read into a typed value, then into the
+ *					cell of its Arrow column; only a set that converted
+ *					completely is appended, so a failed set leaves no trace
+ *					in the batch.  The columns are handed out through the
+ *					Arrow C data interface and own their buffers.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "paramconv.h"
+#include "sqllexer.h"
+#include "decconv.h"
+#include "dtconv.h"
+#include "hexconv.h"
+#include "numconv.h"
+#include "txtconv.h"
+#include "utf8check.h"
+
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#define	NANOS_PER_SECOND	1000000000
+#define	SECONDS_PER_DAY		86400
+
+/* Kinds of Arrow columns a parameter may become */
+typedef enum
+{
+	TK_BOOL,
+	TK_INT,
+	TK_FLOAT,
+	TK_DOUBLE,
+	TK_DECIMAL,
+	TK_UTF8,
+	TK_BINARY,
+	TK_DATE32,
+	TK_DATE64,
+	TK_TIME,
+	TK_TIMESTAMP
+} TargetKind;
+
+typedef struct
+{
+	TargetKind	kind;
+	int		width;		/* bytes of a fixed width value */
+	BOOL		is_signed;
+	int		precision;
+	int		scale;
+	DT_TimeUnit	unit;
+	int		zone_seconds;	/* east of UTC, of a timestamp */
+	BOOL		zone_known;	/* none, UTC or a fixed offset */
+	std::string	format;
+} Target;
+
+/* A bound value as read from the application buffer */
+typedef enum
+{
+	V_NULL,
+	V_INT,
+	V_UINT,
+	V_DOUBLE,
+	V_TEXT,		/* utf8 */
+	V_BINARY,
+	V_DATETIME
+} ValueKind;
+
+typedef struct
+{
+	ValueKind	kind;
+	int64_t		i;
+	uint64_t	u;
+	double		d;
+	const char	*p;
+	size_t		len;
+	SQL_TIMESTAMP_STRUCT	ts;
+	int		dtkind;		/* TX_DATE, TX_TIME or TX_TIMESTAMP */
+} Value;
+
+/* A value converted for its column */
+typedef struct
+{
+	BOOL		null;
+	UCHAR		fixed[32];	/* fixed width values, little-endian */
+	const char	*p;		/* utf8 and binary values */
+	size_t		len;
+	std::string	text;		/* owns 'p' when the value was produced here */
+} Cell;
+
+typedef struct
+{
+	Target		target;
+	std::string	name;
+	std::vector<UCHAR>	validity;
+	std::vector<char>	values;		/* fixed width values, bits for bool */
+	std::vector<int32_t>	offsets;
+	std::vector<char>	data;
+	int64_t		length;
+	int64_t		null_count;
+} ColumnBuilder;
+
+static inline int64_t
+floor_div(int64_t a, int64_t b)
+{
+	int64_t	q = a / b;
+
+	return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+int
+PB_scan_markers(const char *sql, size_t len, size_t *offsets, int max)
+{
+	size_t	i = 0, next;
+	int	count = 0;
+
+	while (i < len)
+	{
+		if (next = LX_skip(sql, len, i), next != i)
+		{
+			i = next;
+			continue;
+		}
+		if ('?' == sql[i])
+		{
+			if (offsets && count < max)
+				offsets[count] = i;
+			count++;
+		}
+		i++;
+	}
+	return count;
+}
+
+static inline BOOL
+is_word_char(char c)
+{
+	return isalnum((UCHAR) c) || '_' == c;
+}
+
+/* Index of the first character of 'sql' from 'i' that is not blank or comment */
+static size_t
+skip_blanks(const char *sql, size_t len, size_t i)
+{
+	while (i < len)
+	{
+		size_t	next;
+
+		if (isspace((UCHAR) sql[i]))
+			i++;
+		else if (('-' == sql[i] || '/' == sql[i]) && (next = LX_skip(sql, len, i)) != i)
+			i = next;
+		else
+			break;
+	}
+	return i;
+}
+
+/* TRUE when the word at 'i' is 'keyword', in any case */
+static BOOL
+word_is(const char *sql, size_t len, size_t i, const char *keyword)
+{
+	size_t	n = strlen(keyword);
+
+	return i + n <= len && 0 == strnicmp(sql + i, keyword, n) &&
+		(i + n == len || !is_word_char(sql[i + n]));
+}
+
+int
+PB_split_statements(const char *sql, size_t len, size_t *begins, size_t *ends, int max)
+{
+	size_t	i = 0, start = 0, next;
+	int	count = 0;
+
+	for (;;)
+	{
+		if (i >= len || ';' == sql[i])
+		{
+			size_t	first;
+
+			if (i > len)
+				i = len;
+			/* nothing but blanks and comments is no statement */
+			if (first = skip_blanks(sql, i, start), first < i)
+			{
+				if (count < max)
+				{
+					begins[count] = first;
+					ends[count] = i;
+				}
+				count++;
+			}
+			if (i >= len)
+				break;
+			start = ++i;
+			continue;
+		}
+		if (next = LX_skip(sql, len, i), next != i)
+			i = next;
+		else
+			i++;
+	}
+	return count;
+}
+
+BOOL
+PB_values_tuple(const char *sql, size_t len, const size_t *offsets, int nmarkers,
+		size_t *begin, size_t *end)
+{
+	size_t	i = skip_blanks(sql, len, 0), open = 0, next;
+	int	depth = 0;
+
+	if (!word_is(sql, len, i, "INSERT"))
+		return FALSE;
+	/* the last VALUES keyword outside parentheses */
+	for (*begin = len; i < len; )
+	{
+		if (next = LX_skip(sql, len, i), next != i)
+		{
+			i = next;
+			continue;
+		}
+		if ('(' == sql[i])
+			depth++;
+		else if (')' == sql[i])
+			depth--;
+		else if (0 == depth && word_is(sql, len, i, "VALUES") &&
+			 (0 == i || !is_word_char(sql[i - 1])))
+		{
+			open = skip_blanks(sql, len, i + 6);
+			if (open < len && '(' == sql[open])
+				*begin = open;
+		}
+		if (is_word_char(sql[i]))
+			while (i < len && is_word_char(sql[i]))
+				i++;
+		else
+			i++;
+	}
+	if (*begin >= len)
+		return FALSE;
+
+	/* its closing parenthesis, with nothing but a semicolon after it */
+	for (i = *begin, depth = 0; i < len; )
+	{
+		if (next = LX_skip(sql, len, i), next != i)
+		{
+			i = next;
+			continue;
+		}
+		if ('(' == sql[i])
+			depth++;
+		else if (')' == sql[i] && 0 == --depth)
+			break;
+		i++;
+	}
+	if (i >= len)
+		return FALSE;
+	*end = i + 1;
+	i = skip_blanks(sql, len, *end);
+	if (i < len && ';' == sql[i])
+		i = skip_blanks(sql, len, i + 1);
+	if (i < len)
+		return FALSE;
+
+	return nmarkers > 0 && offsets[0] > *begin && offsets[nmarkers - 1] < *end;
+}
+
+/*
+ *	The offset of the zone of an Arrow timestamp, in seconds east of UTC:
+ *	none (wall clock values), UTC or "+HH:MM".  FALSE for zone names,
+ *	which would need a zone database.
+ */
+static BOOL
+parse_zone(const char *zone, int *seconds)
+{
+	int	k;
+
+	*seconds = 0;
+	if ('\0' == zone[0] || 0 == strcmp(zone, "UTC") || 0 == strcmp(zone, "Etc/UTC") ||
+	    0 == strcmp(zone, "Z"))
+		return TRUE;
+	if (6 != strlen(zone) || ('+' != zone[0] && '-' != zone[0]) || ':' != zone[3])
+		return FALSE;
+	for (k = 1; k < 6; k++)
+		if (3 != k && !isdigit((UCHAR) zone[k]))
+			return FALSE;
+	*seconds = ((zone[1] - '0') * 10 + zone[2] - '0') * 3600 +
+		((zone[4] - '0') * 10 + zone[5] - '0') * 60;
+	if ('-' == zone[0])
+		*seconds = -*seconds;
+	return TRUE;
+}
+
+/*
+ *	Target types
+ */
+static BOOL
+parse_format(const char *format, Target *t)
+{
+	t->width = 0;
+	t->is_signed = TRUE;
+	t->precision = t->scale = 0;
+	t->unit = DT_MICRO;
+	t->zone_seconds = 0;
+	t->zone_known = TRUE;
+	t->format = format;
+	switch (format[0])
+	{
+		case 'b':
+			t->kind = TK_BOOL;
+			return '\0' == format[1];
+		case 'c': case 'C':
+		case 's': case 'S':
+		case 'i': case 'I':
+		case 'l': case 'L':
+			if ('\0' != format[1])
+				return FALSE;
+			t->kind = TK_INT;
+			t->is_signed = format[0] >= 'a';
+			switch (format[0] | 0x20)
+			{
+				case 'c':
+					t->width = 1;
+					break;
+				case 's':
+					t->width = 2;
+					break;
+				case 'i':
+					t->width = 4;
+					break;
+				default:
+					t->width = 8;
+					break;
+			}
+			return TRUE;
+		case 'f':
+			t->kind = TK_FLOAT;
+			t->width = 4;
+			return '\0' == format[1];
+		case 'g':
+			t->kind = TK_DOUBLE;
+			t->width = 8;
+			return '\0' == format[1];
+		case 'd':
+		{
+			int	bits = 128;
+
+			if (':' != format[1] ||
+			    sscanf(format + 2, "%d,%d,%d", &t->precision, &t->scale, &bits) < 2)
+				return FALSE;
+			if (128 != bits && 256 != bits)
+				return FALSE;
+			t->kind = TK_DECIMAL;
+			t->width = bits / 8;
+			return t->precision > 0 && t->precision <= (128 == bits ? 38 : 76) &&
+				t->scale >= 0 && t->scale <= t->precision;
+		}
+		case 'u':
+			t->kind = TK_UTF8;
+			return '\0' == format[1];
+		case 'z':
+			t->kind = TK_BINARY;
+			return '\0' == format[1];
+		case 't':
+			break;
+		default:
+			return FALSE;
+	}
+
+	if ('d' == format[1] && '\0' == format[3] && ('D' == format[2] || 'm' == format[2]))
+	{
+		t->kind = 'D' == format[2] ? TK_DATE32 : TK_DATE64;
+		t->width = 'D' == format[2] ? 4 : 8;
+		return TRUE;
+	}
+	if ('t' != format[1] && 's' != format[1])
+		return FALSE;
+	switch (format[2])
+	{
+		case 's':
+			t->unit = DT_SECOND;
+			break;
+		case 'm':
+			t->unit = DT_MILLI;
+			break;
+		case 'u':
+			t->unit = DT_MICRO;
+			break;
+		case 'n':
+			t->unit = DT_NANO;
+			break;
+		default:
+			return FALSE;
+	}
+	if ('t' == format[1])
+	{
+		t->kind = TK_TIME;
+		t->width = t->unit <= DT_MILLI ? 4 : 8;
+		return '\0' == format[3];
+	}
+	t->kind = TK_TIMESTAMP;
+	t->width = 8;
+	if (':' != format[3])
+		return FALSE;
+	t->zone_known = parse_zone(format + 4, &t->zone_seconds);
+	return TRUE;
+}
+
+/* The column type of a parameter, from the SQL type of its binding */
+static void
+target_of_binding(const ParamBinding *b, Target *t)
+{
+	char	format[32];
+
+	switch (b->sqltype)
+	{
+		case SQL_BIT:
+			parse_format("b", t);
+			break;
+		case SQL_TINYINT:
+			parse_format("c", t);
+			break;
+		case SQL_SMALLINT:
+			parse_format("s", t);
+			break;
+		case SQL_INTEGER:
+			parse_format("i", t);
+			break;
+		case SQL_BIGINT:
+			parse_format("l", t);
+			break;
+		case SQL_REAL:
+			parse_format("f", t);
+			break;
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			parse_format("g", t);
+			break;
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+		{
+			int	precision = b->column_size > 0 && b->column_size <= 38 ? (int) b->column_size : 38;
+			int	scale = b->decimal_digits < 0 ? 0 : b->decimal_digits;
+
+			if (scale > precision)
+				scale = precision;
+			snprintf(format, sizeof(format), "d:%d,%d", precision, scale);
+			parse_format(format, t);
+			break;
+		}
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+		case SQL_LONGVARBINARY:
+			parse_format("z", t);
+			break;
+		case SQL_TYPE_DATE:
+		case SQL_DATE:
+			parse_format("tdD", t);
+			break;
+		case SQL_TYPE_TIME:
+		case SQL_TIME:
+			parse_format("ttu", t);
+			break;
+		case SQL_TYPE_TIMESTAMP:
+		case SQL_TIMESTAMP:
+			parse_format("tsu:", t);
+			break;
+		default:
+			parse_format("u", t);
+			break;
+	}
+}
+
+/*
+ *	Reading the application buffers
+ */
+
+/* Size of one value of a column-wise bound parameter */
+static SQLLEN
+element_size(const ParamBinding *b)
+{
+	switch (b->ctype)
+	{
+		case SQL_C_BIT:
+		case SQL_C_TINYINT:
+		case SQL_C_STINYINT:
+		case SQL_C_UTINYINT:
+			return 1;
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+		case SQL_C_USHORT:
+			return sizeof(SQLSMALLINT);
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+		case SQL_C_ULONG:
+			return sizeof(SQLINTEGER);
+		case SQL_C_SBIGINT:
+		case SQL_C_UBIGINT:
+			return sizeof(SQLBIGINT);
+		case SQL_C_FLOAT:
+			return sizeof(SQLREAL);
+		case SQL_C_DOUBLE:
+			return sizeof(SQLDOUBLE);
+		case SQL_C_NUMERIC:
+			return sizeof(SQL_NUMERIC_STRUCT);
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+			return sizeof(DATE_STRUCT);
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+			return sizeof(TIME_STRUCT);
+		case SQL_C_TIMESTAMP:
+		case SQL_C_TYPE_TIMESTAMP:
+			return sizeof(TIMESTAMP_STRUCT);
+		case SQL_C_GUID:
+			return sizeof(SQLGUID);
+	}
+	return b->buflen;
+}
+
+static const char *
+value_ptr(const ParamBinding *b, const ParamLayout *layout, SQLULEN row)
+{
+	SQLULEN	stride = SQL_PARAM_BIND_BY_COLUMN == layout->bind_type ? (SQLULEN) element_size(b) : layout->bind_type;
+
+	if (!b->buffer)
+		return NULL;
+	return (const char *) b->buffer + layout->bind_offset + row * stride;
+}
+
+static const SQLLEN *
+indicator_ptr(const ParamBinding *b, const ParamLayout *layout, SQLULEN row)
+{
+	SQLULEN	stride = SQL_PARAM_BIND_BY_COLUMN == layout->bind_type ? sizeof(SQLLEN) : layout->bind_type;
+
+	if (!b->indicator)
+		return NULL;
+	return (const SQLLEN *) ((const char *) b->indicator + layout->bind_offset + row * stride);
+}
+
+BOOL
+PB_is_data_at_exec(const ParamBinding *binding, const ParamLayout *layout, SQLULEN row)
+{
+	const SQLLEN	*ind = indicator_ptr(binding, layout, row);
+
+	return ind && (SQL_DATA_AT_EXEC == *ind || *ind <= SQL_LEN_DATA_AT_EXEC_OFFSET);
+}
+
+template <typename Buffer>
+static void
+put_utf8(uint32_t c, Buffer &out)
+{
+	if (c < 0x80)
+		out.push_back((char) c);
+	else if (c < 0x800)
+	{
+		out.push_back((char) (0xc0 | (c >> 6)));
+		out.push_back((char) (0x80 | (c & 0x3f)));
+	}
+	else if (c < 0x10000)
+	{
+		out.push_back((char) (0xe0 | (c >> 12)));
+		out.push_back((char) (0x80 | ((c >> 6) & 0x3f)));
+		out.push_back((char) (0x80 | (c & 0x3f)));
+	}
+	else
+	{
+		out.push_back((char) (0xf0 | (c >> 18)));
+		out.push_back((char) (0x80 | ((c >> 12) & 0x3f)));
+		out.push_back((char) (0x80 | ((c >> 6) & 0x3f)));
+		out.push_back((char) (0x80 | (c & 0x3f)));
+	}
+}
+
+/* 'count' SQLWCHAR units of 'unit' bytes into utf8; FALSE on a lone surrogate */
+static BOOL
+wide_to_utf8(const char *src, size_t count, size_t unit, std::string &out)
+{
+	size_t	i;
+
+	out.clear();
+	out.reserve(count);
+	for (i = 0; i < count; i++)
+	{
+		uint32_t	c;
+
+		if (4 == unit)
+			memcpy(&c, src + 4 * i, 4);
+		else
+		{
+			uint16_t	u;
+
+			memcpy(&u, src + 2 * i, 2);
+			c = u;
+			if (c >= 0xd800 && c < 0xdc00 && i + 1 < count)
+			{
+				memcpy(&u, src + 2 * (i + 1), 2);
+				if (u >= 0xdc00 && u < 0xe000)
+				{
+					c = 0x10000 + ((c - 0xd800) << 10) + (u - 0xdc00);
+					i++;
+				}
+			}
+		}
+		if ((c >= 0xd800 && c < 0xe000) || c > 0x10ffff)
+			return FALSE;
+		put_utf8(c, out);
+	}
+	return TRUE;
+}
+
+static int
+read_text(const char *p, SQLLEN len, const ParamBinding *b, Value *v)
+{
+	if (SQL_NTS == len)
+	{
+		const char	*end = b->buflen > 0 ? (const char *) memchr(p, '\0', b->buflen) : NULL;
+
+		len = end ? end - p : (SQLLEN) strlen(p);
+	}
+	else if (len < 0)
+		return COPY_GENERAL_ERROR;
+	v->kind = V_TEXT;
+	if (!U8_validate(p, len))
+		return COPY_INVALID_STRING_CONVERSION;
+	v->p = p;
+	v->len = len;
+	return COPY_OK;
+}
+
+static int
+read_wide(const char *p, SQLLEN len, const ParamBinding *b, Value *v, std::string &scratch)
+{
+	size_t	unit = CC_sqlwchar_size(), count;
+
+	if (SQL_NTS == len)
+	{
+		size_t	max = b->buflen > 0 ? b->buflen / unit : (size_t) -1;
+
+		for (count = 0; count < max; count++)
+		{
+			uint32_t	c = 0;
+
+			memcpy(&c, p + count * unit, unit);
+			if (0 == c)
+				break;
+		}
+	}
+	else if (len < 0)
+		return COPY_GENERAL_ERROR;
+	else
+		count = len / unit;
+	if (!wide_to_utf8(p, count, unit, scratch))
+		return COPY_INVALID_STRING_CONVERSION;
+	v->kind = V_TEXT;
+	v->p = scratch.data();
+	v->len = scratch.size();
+	return COPY_OK;
+}
+
+static void
+read_struct_datetime(const char *p, SQLSMALLINT ctype, Value *v)
+{
+	memset(&v->ts, 0, sizeof(v->ts));
+	v->kind = V_DATETIME;
+	switch (ctype)
+	{
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+		{
+			DATE_STRUCT	ds;
+
+			memcpy(&ds, p, sizeof(ds));
+			v->ts.year = ds.year;
+			v->ts.month = ds.month;
+			v->ts.day = ds.day;
+			v->dtkind = TX_DATE;
+			break;
+		}
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+		{
+			TIME_STRUCT	tms;
+
+			memcpy(&tms, p, sizeof(tms));
+			v->ts.hour = tms.hour;
+			v->ts.minute = tms.minute;
+			v->ts.second = tms.second;
+			v->dtkind = TX_TIME;
+			break;
+		}
+		default:
+			memcpy(&v->ts, p, sizeof(v->ts));
+			v->dtkind = TX_TIMESTAMP;
+			break;
+	}
+}
+
+/* Read the value at 'p' of a binding, 'ind' its length or indicator */
+static int
+read_at(const ParamBinding *b, const char *p, const SQLLEN *ind,
+	Value *v, std::string &scratch)
+{
+	SQLLEN		len = ind ? *ind : SQL_NTS;
+
+	v->kind = V_NULL;
+	if (ind && SQL_NULL_DATA == *ind)
+		return COPY_OK;
+	if (!p)
+		return COPY_GENERAL_ERROR;
+
+	switch (b->ctype)
+	{
+		case SQL_C_CHAR:
+			return read_text(p, len, b, v);
+		case SQL_C_WCHAR:
+			return read_wide(p, len, b, v, scratch);
+		case SQL_C_BINARY:
+			if (!ind || SQL_NTS == len)
+				len = b->buflen;
+			if (len < 0)
+				return COPY_GENERAL_ERROR;
+			v->kind = V_BINARY;
+			v->p = p;
+			v->len = len;
+			return COPY_OK;
+		case SQL_C_BIT:
+		case SQL_C_UTINYINT:
+			v->kind = V_UINT;
+			v->u = *(const UCHAR *) p;
+			return COPY_OK;
+		case SQL_C_TINYINT:
+		case SQL_C_STINYINT:
+			v->kind = V_INT;
+			v->i = *(const SCHAR *) p;
+			return COPY_OK;
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+		{
+			SQLSMALLINT	x;
+
+			memcpy(&x, p, sizeof(x));
+			v->kind = V_INT;
+			v->i = x;
+			return COPY_OK;
+		}
+		case SQL_C_USHORT:
+		{
+			SQLUSMALLINT	x;
+
+			memcpy(&x, p, sizeof(x));
+			v->kind = V_UINT;
+			v->u = x;
+			return COPY_OK;
+		}
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+		{
+			SQLINTEGER	x;
+
+			memcpy(&x, p, sizeof(x));
+			v->kind = V_INT;
+			v->i = x;
+			return COPY_OK;
+		}
+		case SQL_C_ULONG:
+		{
+			SQLUINTEGER	x;
+
+			memcpy(&x, p, sizeof(x));
+			v->kind = V_UINT;
+			v->u = x;
+			return COPY_OK;
+		}
+		case SQL_C_SBIGINT:
+			v->kind = V_INT;
+			memcpy(&v->i, p, sizeof(v->i));
+			return COPY_OK;
+		case SQL_C_UBIGINT:
+			v->kind = V_UINT;
+			memcpy(&v->u, p, sizeof(v->u));
+			return COPY_OK;
+		case SQL_C_FLOAT:
+		{
+			SQLREAL	x;
+
+			memcpy(&x, p, sizeof(x));
+			v->kind = V_DOUBLE;
+			v->d = x;
+			return COPY_OK;
+		}
+		case SQL_C_DOUBLE:
+			v->kind = V_DOUBLE;
+			memcpy(&v->d, p, sizeof(v->d));
+			return COPY_OK;
+		case SQL_C_NUMERIC:
+		{
+			SQL_NUMERIC_STRUCT	ns;
+			UCHAR	magnitude[32];
+			char	text[DC_MAX_TEXT + 1];
+			size_t	n;
+
+			/* a 256-bit buffer keeps any 128-bit magnitude positive */
+			memcpy(&ns, p, sizeof(ns));
+			memset(magnitude, 0, sizeof(magnitude));
+			memcpy(magnitude, ns.val, SQL_MAX_NUMERIC_LEN);
+			text[0] = '-';
+			n = DC_format_decimal(magnitude, sizeof(magnitude), ns.scale, text + 1);
+			if (0 == ns.sign)
+				scratch.assign(text, n + 1);
+			else
+				scratch.assign(text + 1, n);
+			v->kind = V_TEXT;
+			v->p = scratch.data();
+			v->len = scratch.size();
+			return COPY_OK;
+		}
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+		case SQL_C_TIMESTAMP:
+		case SQL_C_TYPE_TIMESTAMP:
+			read_struct_datetime(p, b->ctype, v);
+			return COPY_OK;
+		case SQL_C_GUID:
+		{
+			SQLGUID	g;
+			char	text[40];
+
+			memcpy(&g, p, sizeof(g));
+			snprintf(text, sizeof(text), "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+				 (unsigned) g.Data1, g.Data2, g.Data3, g.Data4[0], g.Data4[1],
+				 g.Data4[2], g.Data4[3], g.Data4[4], g.Data4[5], g.Data4[6], g.Data4[7]);
+			scratch.assign(text);
+			v->kind = V_TEXT;
+			v->p = scratch.data();
+			v->len = scratch.size();
+			return COPY_OK;
+		}
+	}
+	return COPY_UNSUPPORTED_TYPE;
+}
+
+/*
+ *	Data at execution
+ */
+struct PutData_
+{
+	SQLSMALLINT	ctype;
+	size_t		size;		/* of a value of fixed width */
+	PTR		token;		/* for SQLParamData */
+	size_t		unit;		/* bytes of a SQLWCHAR */
+	BOOL		null;
+	BOOL		put;		/* SQLPutData was called */
+	int		result;		/* COPY_OK unless a piece failed */
+	std::vector<char>	data;	/* utf8 for SQL_C_WCHAR, as sent for the others */
+	char		pending[8];	/* the incomplete character ending the last piece */
+	size_t		npending;
+};
+
+/*
+ *	Utf8 of up to 'count' SQLWCHAR units appended to 'out'.  '*used' is
+ *	set to the units read, which stops short of a high surrogate at the
+ *	end as its pair may come in the next piece.  FALSE on a lone surrogate.
+ */
+static BOOL
+decode_units(const char *src, size_t count, size_t unit, std::vector<char> &out, size_t *used)
+{
+	size_t	i;
+
+	for (i = 0; i < count; i++)
+	{
+		uint32_t	c;
+
+		if (4 == unit)
+			memcpy(&c, src + 4 * i, 4);
+		else
+		{
+			uint16_t	u;
+
+			memcpy(&u, src + 2 * i, 2);
+			c = u;
+			if (c >= 0xd800 && c < 0xdc00)
+			{
+				if (i + 1 == count)
+					break;
+				memcpy(&u, src + 2 * (i + 1), 2);
+				if (u >= 0xdc00 && u < 0xe000)
+				{
+					c = 0x10000 + ((c - 0xd800) << 10) + (u - 0xdc00);
+					i++;
+				}
+			}
+		}
+		if ((c >= 0xd800 && c < 0xe000) || c > 0x10ffff)
+			return FALSE;
+		put_utf8(c, out);
+	}
+	*used = i;
+	return TRUE;
+}
+
+/* Transcode a piece of SQL_C_WCHAR data, carrying an incomplete character over */
+static int
+put_wide(PutData *pd, const char *p, size_t len)
+{
+	size_t	unit = pd->unit, used;
+
+	if (pd->npending > 0)
+	{
+		char	joined[sizeof(pd->pending) + 8];
+		size_t	take = len < 2 * unit ? len : 2 * unit, n = pd->npending + take;
+
+		memcpy(joined, pd->pending, pd->npending);
+		memcpy(joined + pd->npending, p, take);
+		if (!decode_units(joined, n / unit, unit, pd->data, &used))
+			return COPY_INVALID_STRING_CONVERSION;
+		if (used * unit <= pd->npending)
+		{
+			/* still no complete character */
+			memcpy(pd->pending, joined, n);
+			pd->npending = n;
+			return COPY_OK;
+		}
+		p += used * unit - pd->npending;
+		len -= used * unit - pd->npending;
+		pd->npending = 0;
+	}
+	if (!decode_units(p, len / unit, unit, pd->data, &used))
+		return COPY_INVALID_STRING_CONVERSION;
+	pd->npending = len - used * unit;
+	memcpy(pd->pending, p + used * unit, pd->npending);
+	return COPY_OK;
+}
+
+PutData *
+PB_putdata_create(const ParamBinding *binding, const ParamLayout *layout, SQLULEN row)
+{
+	const SQLLEN	*ind = indicator_ptr(binding, layout, row);
+	SQLLEN		length = *ind <= SQL_LEN_DATA_AT_EXEC_OFFSET ? SQL_LEN_DATA_AT_EXEC_OFFSET - *ind : 0;
+	PutData		*pd = new PutData_;
+
+	pd->ctype = binding->ctype;
+	pd->size = element_size(binding);
+	pd->token = (PTR) value_ptr(binding, layout, row);
+	pd->unit = CC_sqlwchar_size();
+	pd->null = pd->put = FALSE;
+	pd->result = COPY_OK;
+	pd->npending = 0;
+	if (length > 0 && length <= INT32_MAX)
+	{
+		try
+		{
+			pd->data.reserve(SQL_C_WCHAR == pd->ctype ? length / pd->unit : length);
+		}
+		catch (const std::bad_alloc &)
+		{
+			/* only a hint */
+		}
+	}
+	return pd;
+}
+
+void
+PB_putdata_free(PutData *pd)
+{
+	delete pd;
+}
+
+int
+PB_putdata_append(PutData *pd, const void *data, SQLLEN len)
+{
+	const char	*p = (const char *) data;
+
+	pd->put = TRUE;
+	if (SQL_NULL_DATA == len)
+	{
+		pd->null = TRUE;
+		return COPY_OK;
+	}
+	if (SQL_C_CHAR != pd->ctype && SQL_C_WCHAR != pd->ctype && SQL_C_BINARY != pd->ctype)
+		len = pd->size;
+	else if (SQL_NTS == len)
+	{
+		if (SQL_C_WCHAR == pd->ctype)
+		{
+			uint32_t	c;
+
+			for (len = 0; ; len += pd->unit)
+			{
+				c = 0;
+				memcpy(&c, p + len, pd->unit);
+				if (0 == c)
+					break;
+			}
+		}
+		else
+			len = strlen(p);
+	}
+	if (len < 0)
+		return COPY_GENERAL_ERROR;
+	if (SQL_C_WCHAR == pd->ctype)
+		pd->result = CC_worse_result(pd->result, put_wide(pd, p, len));
+	else
+		pd->data.insert(pd->data.end(), p, p + len);
+	return pd->result;
+}
+
+PTR
+PB_putdata_token(const PutData *pd)
+{
+	return pd->token;
+}
+
+BOOL
+PB_putdata_started(const PutData *pd)
+{
+	return pd->put;
+}
+
+BOOL
+PB_putdata_is_null(const PutData *pd)
+{
+	return pd->null;
+}
+
+/* The value collected for a data-at-execution parameter */
+static int
+read_put_data(const ParamBinding *b, PutData *pd, Value *v, std::string &scratch)
+{
+	SQLLEN		len = (SQLLEN) pd->data.size();
+	const char	*p = pd->data.empty() ? "" : pd->data.data();
+
+	v->kind = V_NULL;
+	if (pd->null)
+		return COPY_OK;
+	if (COPY_OK != pd->result)
+		return pd->result;
+	switch (b->ctype)
+	{
+		case SQL_C_WCHAR:
+			if (pd->npending > 0)
+				return COPY_INVALID_STRING_CONVERSION;
+			v->kind = V_TEXT;
+			v->p = p;
+			v->len = len;
+			return COPY_OK;
+		case SQL_C_CHAR:
+		case SQL_C_BINARY:
+			break;
+		default:
+			if (len < (SQLLEN) element_size(b))
+				return COPY_GENERAL_ERROR;
+			break;
+	}
+	return read_at(b, p, &len, v, scratch);
+}
+
+/* Read row 'row' of a binding, 'pd' its data when supplied at execution time */
+static int
+read_value(const ParamBinding *b, const ParamLayout *layout, SQLULEN row,
+	   PutData *pd, Value *v, std::string &scratch)
+{
+	if (PB_is_data_at_exec(b, layout, row))
+	{
+		if (!pd)
+		{
+			v->kind = V_NULL;
+			return COPY_UNSUPPORTED_TYPE;
+		}
+		return read_put_data(b, pd, v, scratch);
+	}
+	return read_at(b, value_ptr(b, layout, row), indicator_ptr(b, layout, row), v, scratch);
+}
+
+/*
+ *	Values into cells
+ */
+
+/* The integral part of a numeric value as a sign and a magnitude */
+static int
+integral_value(const Value *v, BOOL *negative, uint64_t *magnitude)
+{
+	switch (v->kind)
+	{
+		case V_INT:
+			*negative = v->i < 0;
+			*magnitude = v->i < 0 ? (uint64_t) -(v->i + 1) + 1 : (uint64_t) v->i;
+			return COPY_OK;
+		case V_UINT:
+			*negative = FALSE;
+			*magnitude = v->u;
+			return COPY_OK;
+		case V_DOUBLE:
+		{
+			double	t = trunc(v->d);
+
+			if (isnan(t) || fabs(t) >= 18446744073709551616.0)
+				return COPY_NUMERIC_OUT_OF_RANGE;
+			*negative = t < 0;
+			*magnitude = (uint64_t) fabs(t);
+			return t != v->d ? COPY_FRACTION_TRUNCATED : COPY_OK;
+		}
+		case V_TEXT:
+			return TX_parse_integer(v->p, v->len, negative, magnitude);
+		default:
+			break;
+	}
+	return COPY_UNSUPPORTED_CONVERSION;
+}
+
+static int
+to_integer(const Target *t, const Value *v, Cell *cell)
+{
+	BOOL		negative;
+	uint64_t	magnitude, max;
+	int		ret = integral_value(v, &negative, &magnitude);
+
+	if (SQL_ROW_ERROR == CC_row_status(ret))
+		return ret;
+	if (TK_BOOL == t->kind)
+	{
+		if (magnitude > 1 || (negative && magnitude))
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		cell->fixed[0] = (UCHAR) magnitude;
+		return ret;
+	}
+
+	max = 8 == t->width ? ~(uint64_t) 0 : ((uint64_t) 1 << (8 * t->width)) - 1;
+	if (t->is_signed)
+	{
+		max >>= 1;
+		if (magnitude > max + (negative ? 1 : 0))
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		int64_t	x = negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude;
+
+		memcpy(cell->fixed, &x, t->width);	/* little-endian */
+	}
+	else
+	{
+		if ((negative && magnitude) || magnitude > max)
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		memcpy(cell->fixed, &magnitude, t->width);
+	}
+	return ret;
+}
+
+static int
+to_floating(const Target *t, const Value *v, Cell *cell)
+{
+	double	d;
+	int	ret;
+
+	switch (v->kind)
+	{
+		case V_INT:
+			d = (double) v->i;
+			break;
+		case V_UINT:
+			d = (double) v->u;
+			break;
+		case V_DOUBLE:
+			d = v->d;
+			break;
+		case V_TEXT:
+			if (ret = TX_parse_double(v->p, v->len, &d), COPY_OK != ret)
+				return ret;
+			break;
+		default:
+			return COPY_UNSUPPORTED_CONVERSION;
+	}
+	if (TK_FLOAT == t->kind)
+	{
+		float	f = (float) d;
+
+		if (isfinite(d) && fabs(d) > FLT_MAX)
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		memcpy(cell->fixed, &f, sizeof(f));
+	}
+	else
+		memcpy(cell->fixed, &d, sizeof(d));
+	return COPY_OK;
+}
+
+static int
+to_decimal(const Target *t, const Value *v, Cell *cell)
+{
+	char	text[NC_FLOATING_BUFSIZE];
+	size_t	n;
+
+	switch (v->kind)
+	{
+		case V_INT:
+			n = NC_format_int64(v->i, text);
+			break;
+		case V_UINT:
+			n = NC_format_uint64(v->u, text);
+			break;
+		case V_DOUBLE:
+			if (!isfinite(v->d))
+				return COPY_NUMERIC_OUT_OF_RANGE;
+			n = NC_format_double(v->d, text);
+			break;
+		case V_TEXT:
+			return DC_parse_decimal(v->p, v->len, t->precision, t->scale, t->width, cell->fixed);
+		default:
+			return COPY_UNSUPPORTED_CONVERSION;
+	}
+	return DC_parse_decimal(text, n, t->precision, t->scale, t->width, cell->fixed);
+}
+
+/* Text of a date, time or timestamp, the fraction without trailing zeros */
+static size_t
+format_datetime(const SQL_TIMESTAMP_STRUCT *ts, int kind, char *buf)
+{
+	size_t	n = 0;
+
+	if (kind & TX_DATE)
+		n = snprintf(buf, 32, "%04d-%02u-%02u", (int) ts->year, ts->month, ts->day);
+	if (kind & TX_TIME)
+	{
+		int	digits = 9;
+		SQLUINTEGER	fraction = ts->fraction;
+
+		if (kind & TX_DATE)
+			buf[n++] = ' ';
+		n += snprintf(buf + n, 32, "%02u:%02u:%02u", ts->hour, ts->minute, ts->second);
+		while (digits > 0 && 0 == fraction % 10)
+		{
+			fraction /= 10;
+			digits--;
+		}
+		if (digits > 0)
+			n += snprintf(buf + n, 32, ".%0*u", digits, (unsigned) fraction);
+	}
+	return n;
+}
+
+static int
+to_text(const Value *v, Cell *cell)
+{
+	char	buf[64];
+	size_t	n;
+
+	switch (v->kind)
+	{
+		case V_TEXT:
+			cell->p = v->p;
+			cell->len = v->len;
+			return COPY_OK;
+		case V_INT:
+			n = NC_format_int64(v->i, buf);
+			break;
+		case V_UINT:
+			n = NC_format_uint64(v->u, buf);
+			break;
+		case V_DOUBLE:
+			n = NC_format_double(v->d, buf);
+			break;
+		case V_DATETIME:
+			n = format_datetime(&v->ts, v->dtkind, buf);
+			break;
+		case V_BINARY:
+			/* two hex digits a byte, as for binary to character */
+			cell->text.resize(2 * v->len);
+			HX_encode((const UCHAR *) v->p, v->len, &cell->text[0]);
+			cell->p = cell->text.data();
+			cell->len = cell->text.size();
+			return COPY_OK;
+		default:
+			return COPY_UNSUPPORTED_CONVERSION;
+	}
+	cell->text.assign(buf, n);
+	cell->p = cell->text.data();
+	cell->len = n;
+	return COPY_OK;
+}
+
+static BOOL
+valid_datetime(const SQL_TIMESTAMP_STRUCT *ts, int kind)
+{
+	if (kind & TX_DATE)
+	{
+		int64_t		year;
+		unsigned	month, day;
+
+		if (ts->month < 1 || ts->month > 12 || ts->day < 1 || ts->day > 31)
+			return FALSE;
+		DT_civil_from_days(DT_days_from_civil(ts->year, ts->month, ts->day), &year, &month, &day);
+		if (month != ts->month)
+			return FALSE;
+	}
+	if (kind & TX_TIME)
+	{
+		if (ts->hour > 23 || ts->minute > 59 || ts->second > 59 || ts->fraction >= NANOS_PER_SECOND)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static int64_t
+local_today(void)
+{
+	time_t	now = time(NULL);
+	struct tm	tm;
+
+#ifdef	WIN32
+	localtime_s(&tm, &now);
+#else
+	localtime_r(&now, &tm);
+#endif /* WIN32 */
+	return DT_days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+}
+
+static int
+to_temporal(const Target *t, const Value *v, Cell *cell)
+{
+	static const int64_t	per_second[] = {1, 1000, 1000000, NANOS_PER_SECOND};
+	SQL_TIMESTAMP_STRUCT	ts;
+	int		kind, ret = COPY_OK;
+	int64_t		days, seconds, x, divisor;
+
+	if (V_DATETIME == v->kind)
+	{
+		ts = v->ts;
+		kind = v->dtkind;
+	}
+	else if (V_TEXT == v->kind)
+	{
+		if (ret = TX_parse_datetime(v->p, v->len, &ts, &kind), COPY_OK != ret)
+			return ret;
+	}
+	else
+		return COPY_UNSUPPORTED_CONVERSION;
+	if (!valid_datetime(&ts, kind))
+		return V_TEXT == v->kind ? COPY_INVALID_DATETIME_FORMAT : COPY_DATETIME_OVERFLOW;
+
+	days = (kind & TX_DATE) ? DT_days_from_civil(ts.year, ts.month, ts.day) : local_today();
+	seconds = (int64_t) ts.hour * 3600 + ts.minute * 60 + ts.second;
+	switch (t->kind)
+	{
+		case TK_DATE32:
+		case TK_DATE64:
+			if (TX_TIME == kind)
+				return COPY_UNSUPPORTED_CONVERSION;
+			/* a date cannot drop a time of day */
+			if (seconds || ts.fraction)
+				return COPY_DATETIME_OVERFLOW;
+			if (TK_DATE32 == t->kind)
+			{
+				int32_t	d = (int32_t) days;
+
+				memcpy(cell->fixed, &d, sizeof(d));
+			}
+			else
+			{
+				x = days * SECONDS_PER_DAY * 1000;
+				memcpy(cell->fixed, &x, sizeof(x));
+			}
+			return COPY_OK;
+		case TK_TIME:
+			if (TX_DATE == kind)
+				return COPY_UNSUPPORTED_CONVERSION;
+			days = 0;
+			break;
+		default:
+			if (DT_NANO == t->unit && (days < -106751 || days > 106750))
+				return COPY_DATETIME_OVERFLOW;
+			break;
+	}
+
+	divisor = NANOS_PER_SECOND / per_second[t->unit];
+	if (ts.fraction % divisor)
+		ret = COPY_FRACTION_TRUNCATED;
+	x = (days * SECONDS_PER_DAY + seconds) * per_second[t->unit] + ts.fraction / divisor;
+	if (4 == t->width)
+	{
+		int32_t	x32 = (int32_t) x;
+
+		memcpy(cell->fixed, &x32, sizeof(x32));
+	}
+	else
+		memcpy(cell->fixed, &x, sizeof(x));
+	return ret;
+}
+
+static int
+convert_value(const Target *t, const Value *v, Cell *cell)
+{
+	cell->null = V_NULL == v->kind;
+	if (cell->null)
+		return COPY_OK;
+	switch (t->kind)
+	{
+		case TK_BOOL:
+		case TK_INT:
+			return to_integer(t, v, cell);
+		case TK_FLOAT:
+		case TK_DOUBLE:
+			return to_floating(t, v, cell);
+		case TK_DECIMAL:
+			return to_decimal(t, v, cell);
+		case TK_UTF8:
+			return to_text(v, cell);
+		case TK_BINARY:
+			if (V_BINARY != v->kind && V_TEXT != v->kind)
+				return COPY_UNSUPPORTED_CONVERSION;
+			cell->p = v->p;
+			cell->len = v->len;
+			return COPY_OK;
+		default:
+			return to_temporal(t, v, cell);
+	}
+}
+
+/*
+ *	Columns
+ */
+template <typename Byte>
+static inline void
+set_bit(std::vector<Byte> &bits, int64_t i, BOOL on)
+{
+	if ((size_t) (i >> 3) >= bits.size())
+		bits.push_back(0);
+	if (on)
+		bits[i >> 3] |= (Byte) (1 << (i & 7));
+}
+
+/*
+ *	Append a cell to its column.  A variable width value that is all of
+ *	the buffer of a data-at-execution parameter becomes the data of an
+ *	empty column without being copied.
+ */
+static void
+append_cell(ColumnBuilder *cb, const Cell *cell, PutData *pd)
+{
+	int64_t	i = cb->length++;
+
+	if (pd && !cell->null && cb->data.empty() && !pd->data.empty() &&
+	    cell->p == pd->data.data() && cell->len == pd->data.size() &&
+	    (TK_UTF8 == cb->target.kind || TK_BINARY == cb->target.kind))
+	{
+		set_bit(cb->validity, i, TRUE);
+		if (cb->offsets.empty())
+			cb->offsets.push_back(0);
+		cb->data.swap(pd->data);
+		cb->offsets.push_back((int32_t) cb->data.size());
+		return;
+	}
+
+	set_bit(cb->validity, i, !cell->null);
+	if (cell->null)
+		cb->null_count++;
+	switch (cb->target.kind)
+	{
+		case TK_BOOL:
+			set_bit(cb->values, i, !cell->null && cell->fixed[0]);
+			break;
+		case TK_UTF8:
+		case TK_BINARY:
+			if (cb->offsets.empty())
+				cb->offsets.push_back(0);
+			if (!cell->null)
+				cb->data.insert(cb->data.end(), cell->p, cell->p + cell->len);
+			cb->offsets.push_back((int32_t) cb->data.size());
+			break;
+		default:
+			if (cell->null)
+				cb->values.insert(cb->values.end(), cb->target.width, '\0');
+			else
+				cb->values.insert(cb->values.end(), (const char *) cell->fixed,
+						  (const char *) cell->fixed + cb->target.width);
+			break;
+	}
+}
+
+/* The buffers of one exported column */
+typedef struct
+{
+	std::vector<UCHAR>	validity;
+	std::vector<char>	values;
+	std::vector<int32_t>	offsets;
+	std::vector<char>	data;
+	const void		*buffers[3];
+} ExportedColumn;
+
+typedef struct
+{
+	std::vector<struct ArrowArray *>	children;
+	const void		*buffers[1];
+} ExportedBatch;
+
+typedef struct
+{
+	std::string		format;
+	std::string		name;
+	std::vector<struct ArrowSchema *>	children;
+} ExportedSchema;
+
+static void
+release_column(struct ArrowArray *array)
+{
+	delete (ExportedColumn *) array->private_data;
+	array->release = NULL;
+}
+
+static void
+release_batch(struct ArrowArray *array)
+{
+	ExportedBatch	*eb = (ExportedBatch *) array->private_data;
+	size_t	k;
+
+	for (k = 0; k < eb->children.size(); k++)
+	{
+		if (eb->children[k]->release)
+			eb->children[k]->release(eb->children[k]);
+		delete eb->children[k];
+	}
+	delete eb;
+	array->release = NULL;
+}
+
+static void
+release_schema(struct ArrowSchema *schema)
+{
+	ExportedSchema	*es = (ExportedSchema *) schema->private_data;
+	size_t	k;
+
+	for (k = 0; k < es->children.size(); k++)
+	{
+		if (es->children[k]->release)
+			es->children[k]->release(es->children[k]);
+		delete es->children[k];
+	}
+	delete es;
+	schema->release = NULL;
+}
+
+static void
+init_schema(struct ArrowSchema *schema, ExportedSchema *es, int64_t flags)
+{
+	memset(schema, 0, sizeof(*schema));
+	schema->format = es->format.c_str();
+	schema->name = es->name.c_str();
+	schema->flags = flags;
+	schema->private_data = es;
+	schema->release = release_schema;
+}
+
+static void
+export_column(ColumnBuilder *cb, struct ArrowArray *array)
+{
+	ExportedColumn	*ec = new ExportedColumn;
+
+	memset(array, 0, sizeof(*array));
+	array->length = cb->length;
+	array->null_count = cb->null_count;
+	array->private_data = ec;
+	array->release = release_column;
+	ec->validity.swap(cb->validity);
+	ec->values.swap(cb->values);
+	ec->offsets.swap(cb->offsets);
+	ec->data.swap(cb->data);
+	if (ec->offsets.empty())
+		ec->offsets.push_back(0);
+	ec->buffers[0] = array->null_count ? ec->validity.data() : NULL;
+	if (TK_UTF8 == cb->target.kind || TK_BINARY == cb->target.kind)
+	{
+		ec->buffers[1] = ec->offsets.data();
+		ec->buffers[2] = ec->data.data();
+		array->n_buffers = 3;
+	}
+	else
+	{
+		ec->buffers[1] = ec->values.data();
+		array->n_buffers = 2;
+	}
+	array->buffers = ec->buffers;
+}
+
+static void
+export_batch(std::vector<ColumnBuilder> &columns, int64_t length,
+	     struct ArrowSchema *schema, struct ArrowArray *batch)
+{
+	ExportedSchema	*es = new ExportedSchema;
+	ExportedBatch	*eb;
+	size_t	k;
+
+	es->format = "+s";
+	init_schema(schema, es, 0);
+	eb = new ExportedBatch;
+	memset(batch, 0, sizeof(*batch));
+	batch->length = length;
+	batch->n_buffers = 1;
+	eb->buffers[0] = NULL;
+	batch->buffers = eb->buffers;
+	batch->private_data = eb;
+	batch->release = release_batch;
+
+	for (k = 0; k < columns.size(); k++)
+	{
+		ExportedSchema	*field = new ExportedSchema;
+		struct ArrowSchema	*child_schema;
+		struct ArrowArray	*child;
+
+		field->format = columns[k].target.format;
+		field->name = columns[k].name;
+		child_schema = new struct ArrowSchema;
+		init_schema(child_schema, field, ARROW_FLAG_NULLABLE);
+		es->children.push_back(child_schema);
+		schema->children = es->children.data();
+		schema->n_children = es->children.size();
+
+		child = new struct ArrowArray;
+		child->release = NULL;
+		eb->children.push_back(child);
+		batch->children = eb->children.data();
+		batch->n_children = eb->children.size();
+		export_column(&columns[k], child);
+	}
+}
+
+int
+PB_build_batch(const ParamBinding *params, int nparams, const ParamLayout *layout,
+	       PutData *const *put_data,
+	       struct ArrowSchema *schema, struct ArrowArray *batch, int *row_results)
+{
+	std::vector<ColumnBuilder>	columns(nparams);
+	std::vector<Value>	values(nparams);
+	std::vector<Cell>	cells(nparams);
+	std::vector<std::string>	scratch(nparams);
+	int64_t		length = 0;
+	int		result = COPY_OK, k;
+	SQLULEN		row;
+
+#define	PUT_DATA(row, k)	(put_data ? put_data[(row) * nparams + (k)] : NULL)
+	for (k = 0; k < nparams; k++)
+	{
+		char	name[16];
+
+		target_of_binding(&params[k], &columns[k].target);
+		snprintf(name, sizeof(name), "p%d", k + 1);
+		columns[k].name = name;
+		columns[k].length = columns[k].null_count = 0;
+	}
+
+	for (row = 0; row < layout->nrows; row++)
+	{
+		int	ret = COPY_OK;
+
+		if (layout->operations && SQL_PARAM_IGNORE == layout->operations[row])
+		{
+			row_results[row] = COPY_NO_DATA_FOUND;
+			continue;
+		}
+		for (k = 0; k < nparams && SQL_ROW_ERROR != CC_row_status(ret); k++)
+		{
+			int	r = read_value(&params[k], layout, row, PUT_DATA(row, k),
+					       &values[k], scratch[k]);
+
+			if (SQL_ROW_ERROR != CC_row_status(r))
+				r = CC_worse_result(r, convert_value(&columns[k].target, &values[k], &cells[k]));
+			ret = CC_worse_result(ret, r);
+		}
+		/* variable width columns are addressed by int32 offsets */
+		for (k = 0; k < nparams && SQL_ROW_ERROR != CC_row_status(ret); k++)
+		{
+			TargetKind	kind = columns[k].target.kind;
+
+			if ((TK_UTF8 == kind || TK_BINARY == kind) && !cells[k].null &&
+			    columns[k].data.size() + cells[k].len > INT32_MAX)
+				ret = COPY_GENERAL_ERROR;
+		}
+		if (SQL_ROW_ERROR != CC_row_status(ret))
+		{
+			for (k = 0; k < nparams; k++)
+				append_cell(&columns[k], &cells[k], PUT_DATA(row, k));
+			length++;
+		}
+		row_results[row] = ret;
+		result = CC_worse_result(result, ret);
+	}
+#undef	PUT_DATA
+
+	schema->release = NULL;
+	batch->release = NULL;
+	try
+	{
+		export_batch(columns, length, schema, batch);
+	}
+	catch (...)
+	{
+		if (batch->release)
+			batch->release(batch);
+		if (schema->release)
+			schema->release(schema);
+		throw;
+	}
+	return result;
+}
+
+/*
+ *	Literals
+ */
+static void
+append_datetime_literal(const char *keyword, int64_t days, int64_t nanos,
+			int kind, std::string &out)
+{
+	SQL_TIMESTAMP_STRUCT	ts;
+	int64_t		year;
+	unsigned	month, day;
+	char		buf[64];
+
+	memset(&ts, 0, sizeof(ts));
+	if (kind & TX_DATE)
+	{
+		DT_civil_from_days(days, &year, &month, &day);
+		ts.year = (SQLSMALLINT) year;
+		ts.month = month;
+		ts.day = day;
+	}
+	ts.hour = (SQLUSMALLINT) (nanos / (3600LL * NANOS_PER_SECOND));
+	ts.minute = (SQLUSMALLINT) (nanos / (60LL * NANOS_PER_SECOND) % 60);
+	ts.second = (SQLUSMALLINT) (nanos / NANOS_PER_SECOND % 60);
+	ts.fraction = (SQLUINTEGER) (nanos % NANOS_PER_SECOND);
+	out += keyword;
+	out += " '";
+	out.append(buf, format_datetime(&ts, kind, buf));
+	out += '\'';
+}
+
+/* TRUE for the bytes a plain string literal should not carry as they are */
+static BOOL
+needs_unicode_escape(UCHAR c)
+{
+	return '\\' == c || c < 0x20 || 0x7f == c;
+}
+
+/*
+ *	Append 'len' bytes of utf8 as a string literal, quotes doubled.  Text
+ *	with backslashes or control characters becomes a Unicode literal,
+ *	U&'...', with those escaped as \\ and \XXXX, so no byte of the value
+ *	can end the literal or mean anything else to the server.
+ */
+static void
+append_string_literal(const char *p, size_t len, std::string &out)
+{
+	static const char	hex[] = "0123456789ABCDEF";
+	BOOL	unicode = FALSE;
+	size_t	k;
+
+	for (k = 0; k < len && !unicode; k++)
+		unicode = needs_unicode_escape((UCHAR) p[k]);
+	out += unicode ? "U&'" : "'";
+	for (k = 0; k < len; k++)
+	{
+		UCHAR	c = (UCHAR) p[k];
+
+		if ('\'' == c)
+			out += "''";
+		else if (unicode && '\\' == c)
+			out += "\\\\";
+		else if (unicode && needs_unicode_escape(c))
+		{
+			out += "\\00";
+			out += hex[c >> 4];
+			out += hex[c & 0xf];
+		}
+		else
+			out += (char) c;
+	}
+	out += '\'';
+}
+
+/*
+ *	A number of 'len' characters in 'buf'; a negative one goes in
+ *	parentheses so that a minus before the marker does not make it a
+ *	comment, "a-?" with -1 becoming "a-(-1)" rather than "a--1".
+ */
+static void
+append_number(const char *buf, size_t len, std::string &out)
+{
+	if (len > 0 && '-' == buf[0])
+	{
+		out += '(';
+		out.append(buf, len);
+		out += ')';
+	}
+	else
+		out.append(buf, len);
+}
+
+static void
+append_literal(const struct ArrowSchema *field, const struct ArrowArray *column,
+	       int64_t row, std::string &out)
+{
+	static const int64_t	nanos_per_unit[] = {NANOS_PER_SECOND, 1000000, 1000, 1};
+	const UCHAR	*validity = (const UCHAR *) column->buffers[0];
+	const char	*values = (const char *) column->buffers[1];
+	int64_t		i = column->offset + row;
+	char		buf[DC_MAX_TEXT];
+	Target		t;
+
+	if (!parse_format(field->format, &t) ||
+	    (validity && 0 == ((validity[i >> 3] >> (i & 7)) & 1)))
+	{
+		out += "NULL";
+		return;
+	}
+	switch (t.kind)
+	{
+		case TK_BOOL:
+			out += ((values[i >> 3] >> (i & 7)) & 1) ? "TRUE" : "FALSE";
+			break;
+		case TK_INT:
+		{
+			uint64_t	u = 0;
+
+			memcpy(&u, values + i * t.width, t.width);
+			if (t.is_signed && t.width < 8 && (u >> (8 * t.width - 1)))
+				u |= ~(uint64_t) 0 << (8 * t.width);
+			append_number(buf, t.is_signed ? NC_format_int64((int64_t) u, buf) : NC_format_uint64(u, buf), out);
+			break;
+		}
+		case TK_FLOAT:
+		case TK_DOUBLE:
+		{
+			double	d;
+			float	f;
+
+			if (TK_FLOAT == t.kind)
+			{
+				memcpy(&f, values + i * 4, 4);
+				d = f;
+			}
+			else
+				memcpy(&d, values + i * 8, 8);
+			if (!isfinite(d))
+				out += isnan(d) ? "CAST('NaN' AS DOUBLE)" : d > 0 ? "CAST('Infinity' AS DOUBLE)" : "CAST('-Infinity' AS DOUBLE)";
+			else
+				append_number(buf, TK_FLOAT == t.kind ? NC_format_float(f, buf) : NC_format_double(d, buf), out);
+			break;
+		}
+		case TK_DECIMAL:
+			append_number(buf, DC_format_decimal(values + i * t.width, t.width, t.scale, buf), out);
+			break;
+		case TK_UTF8:
+		case TK_BINARY:
+		{
+			const int32_t	*offsets = (const int32_t *) column->buffers[1];
+			const char	*data = (const char *) column->buffers[2];
+			const char	*p = data + offsets[i];
+			size_t		len = offsets[i + 1] - offsets[i];
+
+			if (TK_BINARY == t.kind)
+			{
+				size_t	at;
+
+				out += "X'";
+				at = out.size();
+				out.resize(at + 2 * len);
+				HX_encode((const UCHAR *) p, len, &out[at]);
+				out += '\'';
+				break;
+			}
+			append_string_literal(p, len, out);
+			break;
+		}
+		case TK_DATE32:
+		{
+			int32_t	d;
+
+			memcpy(&d, values + i * 4, 4);
+			append_datetime_literal("DATE", d, 0, TX_DATE, out);
+			break;
+		}
+		case TK_DATE64:
+		{
+			int64_t	ms;
+
+			memcpy(&ms, values + i * 8, 8);
+			append_datetime_literal("DATE", floor_div(ms, SECONDS_PER_DAY * 1000), 0, TX_DATE, out);
+			break;
+		}
+		case TK_TIME:
+		case TK_TIMESTAMP:
+		{
+			int64_t		x = 0, per_day, days;
+
+			if (4 == t.width)
+			{
+				int32_t	x32;
+
+				memcpy(&x32, values + i * 4, 4);
+				x = x32;
+			}
+			else
+				memcpy(&x, values + i * 8, 8);
+			/* the wall clock time of the zone, as the literal has none */
+			if (TK_TIMESTAMP == t.kind)
+				x += (int64_t) t.zone_seconds * (NANOS_PER_SECOND / nanos_per_unit[t.unit]);
+			per_day = (int64_t) SECONDS_PER_DAY * (NANOS_PER_SECOND / nanos_per_unit[t.unit]);
+			days = floor_div(x, per_day);
+			x = (x - days * per_day) * nanos_per_unit[t.unit];
+			if (TK_TIME == t.kind)
+				append_datetime_literal("TIME", 0, x, TX_TIME, out);
+			else
+				append_datetime_literal("TIMESTAMP", days, x, TX_TIMESTAMP, out);
+			break;
+		}
+	}
+}
+
+BOOL
+PB_can_inline(const struct ArrowSchema *schema)
+{
+	Target	t;
+	int64_t	k;
+
+	for (k = 0; k < schema->n_children; k++)
+		if (schema->children[k]->dictionary || !parse_format(schema->children[k]->format, &t))
+			return FALSE;
+	return TRUE;
+}
+
+BOOL
+PB_zones_known(const struct ArrowSchema *schema)
+{
+	Target	t;
+	int64_t	k;
+
+	for (k = 0; k < schema->n_children; k++)
+		if (parse_format(schema->children[k]->format, &t) && !t.zone_known)
+			return FALSE;
+	return TRUE;
+}
+
+char *
+PB_inline_literals(const char *sql, size_t len, const size_t *offsets,
+		   int nmarkers, const struct ArrowSchema *schema,
+		   const struct ArrowArray *batch, int64_t row, size_t *outlen)
+{
+	std::string	out;
+	size_t		from = 0;
+	char		*result;
+	int		k;
+
+	try
+	{
+		out.reserve(len + 16 * nmarkers);
+		for (k = 0; k < nmarkers; k++)
+		{
+			out.append(sql + from, offsets[k] - from);
+			if (k < batch->n_children && k < schema->n_children)
+				append_literal(schema->children[k], batch->children[k], batch->offset + row, out);
+			else
+				out += "NULL";
+			from = offsets[k] + 1;
+		}
+		out.append(sql + from, len - from);
+	}
+	catch (const std::bad_alloc &)
+	{
+		return NULL;
+	}
+	if (result = (char *) malloc(out.size() + 1), !result)
+		return NULL;
+	memcpy(result, out.c_str(), out.size() + 1);
+	if (outlen)
+		*outlen = out.size();
+	return result;
+}
@@ -0,0 +1,142 @@
+/* File:			paramconv.h
+ *
+ * Description:		See "paramconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __PARAMCONV_H__
+#define __PARAMCONV_H__
+
+#include "colconv.h"
+#include "arrowabi.h"
+
+/* One parameter as bound by SQLBindParameter: its APD and IPD records */
+typedef struct
+{
+	SQLSMALLINT	param_type;	/* SQL_PARAM_INPUT */
+	SQLSMALLINT	ctype;		/* never SQL_C_DEFAULT */
+	SQLSMALLINT	sqltype;
+	SQLULEN		column_size;
+	SQLSMALLINT	decimal_digits;
+	PTR		buffer;		/* ParameterValuePtr */
+	SQLLEN		buflen;		/* BufferLength */
+	SQLLEN		*indicator;	/* StrLen_or_IndPtr */
+} ParamBinding;
+
+/*
+ *	Geometry of the parameter buffers: SQL_ATTR_PARAMSET_SIZE rows, bound
+ *	column-wise or row-wise (SQL_ATTR_PARAM_BIND_TYPE), with the bind
+ *	offset (SQL_ATTR_PARAM_BIND_OFFSET_PTR) added to every pointer.  Rows
+ *	marked SQL_PARAM_IGNORE in 'operations' (SQL_ATTR_PARAM_OPERATION_PTR)
+ *	are skipped.
+ */
+typedef struct
+{
+	SQLULEN		nrows;
+	SQLULEN		bind_type;	/* SQL_PARAM_BIND_BY_COLUMN or the row size */
+	SQLLEN		bind_offset;
+	const SQLUSMALLINT	*operations;	/* NULL to process every row */
+} ParamLayout;
+
+/*
+ *	Number of parameter markers in 'len' bytes of 'sql': question marks
+ *	outside string literals, quoted identifiers and comments.  The byte
+ *	offsets of the first 'max' of them are stored in 'offsets' when it is
+ *	not NULL.
+ */
+int	PB_scan_markers(const char *sql, size_t len, size_t *offsets, int max);
+
+/*
+ *	TRUE when row 'row' of a binding is supplied at execution time
+ *	(SQL_DATA_AT_EXEC or SQL_LEN_DATA_AT_EXEC).
+ */
+BOOL	PB_is_data_at_exec(const ParamBinding *binding, const ParamLayout *layout, SQLULEN row);
+
+/*
+ *	The value of a parameter supplied at execution time, row 'row' of a
+ *	binding, collected from the pieces of SQLPutData.  Character and
+ *	binary pieces are appended to one growing buffer, reserved up front
+ *	when SQL_LEN_DATA_AT_EXEC gave the length, and SQL_C_WCHAR pieces are
+ *	transcoded to utf8 as they come.  PB_putdata_create() throws
+ *	std::bad_alloc.
+ */
+typedef struct PutData_ PutData;
+
+PutData	*PB_putdata_create(const ParamBinding *binding, const ParamLayout *layout, SQLULEN row);
+void	PB_putdata_free(PutData *pd);
+/* One SQLPutData call; returns COPY_OK or the result of the first piece that failed */
+int	PB_putdata_append(PutData *pd, const void *data, SQLLEN len);
+/* The ParameterValuePtr of the row, which SQLParamData hands back */
+PTR	PB_putdata_token(const PutData *pd);
+BOOL	PB_putdata_started(const PutData *pd);
+BOOL	PB_putdata_is_null(const PutData *pd);
+
+/*
+ *	Convert the bound parameter values into one Arrow record batch: a
+ *	struct array with a child per parameter and a row per parameter set.
+ *	Each child takes its type from the SQL type of the binding.
+ *
+ *	'put_data' holds 'nrows' times 'nparams' entries, row by row, with the
+ *	values of the data-at-execution parameters; it may be NULL when there
+ *	are none.  A variable width value collected there is moved into the
+ *	batch rather than copied when no value came before it in its column.
+ *
+ *	'row_results' receives the COPY_xxx result of each of the 'nrows'
+ *	parameter sets; a set that fails is left out of the batch, so the
+ *	batch may be shorter than 'nrows'.  An ignored set is left out too,
+ *	with COPY_NO_DATA_FOUND.  Returns the worst result.  The
+ *	caller owns 'schema' and 'batch' and releases them.  Throws
+ *	std::bad_alloc when out of memory.
+ */
+int	PB_build_batch(const ParamBinding *params, int nparams, const ParamLayout *layout,
+			PutData *const *put_data,
+			struct ArrowSchema *schema, struct ArrowArray *batch, int *row_results);
+
+/*
+ *	Number of statements in 'len' bytes of 'sql', separated by semicolons
+ *	outside string literals, quoted identifiers and comments.  A piece
+ *	with nothing but blanks and comments is not one.  Where the first
+ *	'max' of them begin, past leading blanks, and end, at their semicolon,
+ *	is stored in 'begins' and 'ends'.
+ */
+int	PB_split_statements(const char *sql, size_t len, size_t *begins, size_t *ends, int max);
+
+/*
+ *	TRUE when 'sql' is an INSERT whose only row of values is the
+ *	parenthesized list between the byte offsets 'begin' and 'end', holding
+ *	all 'nmarkers' markers.  Repeating that list once per parameter set
+ *	inserts many sets with one statement.
+ */
+BOOL	PB_values_tuple(const char *sql, size_t len, const size_t *offsets, int nmarkers,
+			size_t *begin, size_t *end);
+
+/*
+ *	The text of 'sql' with its markers, at the 'nmarkers' byte offsets
+ *	from PB_scan_markers(), replaced by SQL literals of the values of row
+ *	'row' of a batch from PB_build_batch().  Quotes in strings are doubled,
+ *	and a string with backslashes or control characters is written as a
+ *	U&'...' literal with them escaped.  Negative numbers are put in
+ *	parentheses, so a minus before a marker cannot start a comment.
+ *	Returns a malloc'ed, terminated string and its length, or NULL when
+ *	out of memory.
+ */
+char	*PB_inline_literals(const char *sql, size_t len, const size_t *offsets,
+			int nmarkers, const struct ArrowSchema *schema,
+			const struct ArrowArray *batch, int64_t row, size_t *outlen);
+
+/*
+ *	TRUE when every column of 'schema' has a type PB_inline_literals()
+ *	can render; the others would be sent as NULL.
+ */
+BOOL	PB_can_inline(const struct ArrowSchema *schema);
+
+/*
+ *	TRUE when every timestamp column of 'schema' has no zone, UTC or a
+ *	fixed offset such as "+05:30"; PB_inline_literals() writes those as
+ *	the wall clock time of their zone.  Named zones are not converted.
+ */
+BOOL	PB_zones_known(const struct ArrowSchema *schema);
+
+#endif /* __PARAMCONV_H__ */
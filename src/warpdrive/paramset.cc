@@ -0,0 +1,726 @@
+/*-------
+ * Module:			paramset.cc
+ *
+ * Description:		This module contains the parameter state of statements
+ *					and the execution of statements with parameters.
+ *
+ *					Flight SQL takes parameter values as an Arrow batch
+ *					bound to the prepared statement, which the Flight SQL
+ *					driver in this tree cannot send.  The parameters are
+ *					substituted on the client instead: the bound values of
+ *					every execution, all SQL_ATTR_PARAMSET_SIZE sets of
+ *					them, are converted into one Arrow batch, checked and
+ *					typed there, and rendered into the statement text as
+ *					escaped SQL literals at the markers.  An INSERT of one
+ *					row of values gets a row per set; other statements run
+ *					once per set.
+ *
+ *					An application with its parameters already in Arrow
+ *					form sets an ArrowArrayStream instead, whose batches are
+ *					rendered the same way, one after the other.
+ *
+ * Classes:			ParamSet
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "paramset.h"
+#include "extension.h"
+#include "mylog.h"
+#include "wdapifunc.h"
+
+#include <string>
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCStatement;
+
+struct ParamSet_
+{
+	std::vector<ParamBinding>	bindings;	/* param_type 0 when unbound */
+	std::string		query;
+	std::vector<size_t>	markers;	/* byte offsets in 'query' */
+
+	/* statement attributes of parameter arrays */
+	SQLULEN			paramset_size;
+	SQLULEN			bind_type;
+	SQLULEN			*bind_offset_ptr;
+	SQLUSMALLINT		*operation_ptr;
+	SQLUSMALLINT		*status_ptr;
+	SQLULEN			*processed_ptr;
+
+	struct ArrowArrayStream	stream;		/* SQL_ATTR_WD_PARAM_STREAM, release NULL when none */
+
+	/* an execution waiting for data-at-execution values */
+	BOOL			need_data;
+	ParamLayout		exec_layout;
+	std::vector<PutData *>	put_data;	/* row by row, NULL where bound */
+	size_t			next_put;	/* where to look for the next one */
+	PutData			*current;	/* the one SQLPutData goes to */
+	SQLSMALLINT		current_ctype;
+};
+
+/* Upper bound on the text of one statement sent with inline values */
+#define	MAX_INLINE_STATEMENT	(4 * 1024 * 1024)
+/* Column size described for a parameter not bound yet */
+#define	UNBOUNDED_COLUMN_SIZE	65535
+
+/* Releases a schema and a batch, either may be NULL, on the way out unless they were handed over */
+class ArrowGuard
+{
+public:
+	ArrowGuard(struct ArrowSchema *schema, struct ArrowArray *batch)
+		: schema_(schema), batch_(batch) {}
+	~ArrowGuard()
+	{
+		if (batch_ && batch_->release)
+			batch_->release(batch_);
+		if (schema_ && schema_->release)
+			schema_->release(schema_);
+	}
+
+private:
+	struct ArrowSchema	*schema_;
+	struct ArrowArray	*batch_;
+};
+
+class StreamGuard
+{
+public:
+	StreamGuard(struct ArrowArrayStream *stream) : stream_(stream) {}
+	~StreamGuard()
+	{
+		if (stream_->release)
+			stream_->release(stream_);
+	}
+
+private:
+	struct ArrowArrayStream	*stream_;
+};
+
+/* Forget an execution waiting for data-at-execution values */
+static void
+clear_put_data(ParamSet *ps)
+{
+	size_t	i;
+
+	for (i = 0; i < ps->put_data.size(); i++)
+		if (ps->put_data[i])
+			PB_putdata_free(ps->put_data[i]);
+	ps->put_data.clear();
+	ps->need_data = FALSE;
+	ps->current = NULL;
+}
+
+ParamSet *
+PS_get(ODBCStatement *stmt, BOOL create)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+	ParamSet	*ps;
+
+	if (ext->params || !create)
+		return ext->params;
+	ps = new ParamSet_;
+	ps->paramset_size = 1;
+	ps->bind_type = SQL_PARAM_BIND_BY_COLUMN;
+	ps->bind_offset_ptr = NULL;
+	ps->operation_ptr = NULL;
+	ps->status_ptr = NULL;
+	ps->processed_ptr = NULL;
+	ps->stream.release = NULL;
+	ps->need_data = FALSE;
+	ps->current = NULL;
+	ext->params = ps;
+	return ps;
+}
+
+void
+PS_drop(ODBCStatement *stmt)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+	ParamSet	*ps = ext->params;
+
+	if (!ps)
+		return;
+	ext->params = NULL;
+	if (ps->stream.release)
+		ps->stream.release(&ps->stream);
+	clear_put_data(ps);
+	delete ps;
+}
+
+/* The C type SQL_C_DEFAULT stands for */
+static SQLSMALLINT
+default_ctype(SQLSMALLINT sqltype)
+{
+	switch (sqltype)
+	{
+		case SQL_WCHAR:
+		case SQL_WVARCHAR:
+		case SQL_WLONGVARCHAR:
+			return SQL_C_WCHAR;
+		case SQL_BIT:
+			return SQL_C_BIT;
+		case SQL_TINYINT:
+			return SQL_C_STINYINT;
+		case SQL_SMALLINT:
+			return SQL_C_SSHORT;
+		case SQL_INTEGER:
+			return SQL_C_SLONG;
+		case SQL_BIGINT:
+			return SQL_C_SBIGINT;
+		case SQL_REAL:
+			return SQL_C_FLOAT;
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return SQL_C_DOUBLE;
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+		case SQL_LONGVARBINARY:
+			return SQL_C_BINARY;
+		case SQL_TYPE_DATE:
+			return SQL_C_TYPE_DATE;
+		case SQL_TYPE_TIME:
+			return SQL_C_TYPE_TIME;
+		case SQL_TYPE_TIMESTAMP:
+			return SQL_C_TYPE_TIMESTAMP;
+		case SQL_GUID:
+			return SQL_C_GUID;
+	}
+	return SQL_C_CHAR;
+}
+
+void
+PS_bind(ParamSet *ps, SQLUSMALLINT ipar, SQLSMALLINT param_type,
+	SQLSMALLINT ctype, SQLSMALLINT sqltype, SQLULEN column_size,
+	SQLSMALLINT decimal_digits, PTR buffer, SQLLEN buflen, SQLLEN *indicator)
+{
+	ParamBinding	*b;
+
+	if (ipar < 1)
+		throw DriverException("Invalid descriptor index", "07009");
+	switch (param_type)
+	{
+		case SQL_PARAM_INPUT:
+			break;
+		case SQL_PARAM_INPUT_OUTPUT:
+		case SQL_PARAM_OUTPUT:
+			throw DriverException("Output parameters are not supported", "HYC00");
+		default:
+			throw DriverException("Invalid parameter type", "HY105");
+	}
+	if (buflen < 0)
+		throw DriverException("Invalid string or buffer length", "HY090");
+
+	if (ps->bindings.size() < ipar)
+	{
+		ParamBinding	unbound;
+
+		memset(&unbound, 0, sizeof(unbound));
+		ps->bindings.resize(ipar, unbound);
+	}
+	b = &ps->bindings[ipar - 1];
+	b->param_type = param_type;
+	b->ctype = SQL_C_DEFAULT == ctype ? default_ctype(sqltype) : ctype;
+	b->sqltype = sqltype;
+	b->column_size = column_size;
+	b->decimal_digits = decimal_digits;
+	b->buffer = buffer;
+	b->buflen = buflen;
+	b->indicator = indicator;
+}
+
+void
+PS_unbind(ParamSet *ps)
+{
+	ps->bindings.clear();
+}
+
+BOOL
+PS_set_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	switch (attr)
+	{
+		case SQL_ATTR_PARAMSET_SIZE:
+			if (0 == (SQLULEN) value)
+				throw DriverException("Invalid attribute value", "HY024");
+			PS_get(stmt, TRUE)->paramset_size = (SQLULEN) value;
+			return TRUE;
+		case SQL_ATTR_PARAM_BIND_TYPE:
+			PS_get(stmt, TRUE)->bind_type = (SQLULEN) value;
+			return TRUE;
+		case SQL_ATTR_PARAM_BIND_OFFSET_PTR:
+			PS_get(stmt, TRUE)->bind_offset_ptr = (SQLULEN *) value;
+			return TRUE;
+		case SQL_ATTR_PARAM_OPERATION_PTR:
+			PS_get(stmt, TRUE)->operation_ptr = (SQLUSMALLINT *) value;
+			return TRUE;
+		case SQL_ATTR_PARAM_STATUS_PTR:
+			PS_get(stmt, TRUE)->status_ptr = (SQLUSMALLINT *) value;
+			return TRUE;
+		case SQL_ATTR_PARAMS_PROCESSED_PTR:
+			PS_get(stmt, TRUE)->processed_ptr = (SQLULEN *) value;
+			return TRUE;
+		case SQL_ATTR_WD_PARAM_STREAM:
+		{
+			ParamSet	*ps = PS_get(stmt, TRUE);
+			struct ArrowArrayStream	*stream = (struct ArrowArrayStream *) value;
+
+			if (ps->stream.release)
+				ps->stream.release(&ps->stream);
+			if (stream && stream->release)
+			{
+				/* moved in, as the C stream interface has it */
+				ps->stream = *stream;
+				stream->release = NULL;
+			}
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+BOOL
+PS_get_attr(ODBCStatement *stmt, SQLINTEGER attr, PTR value)
+{
+	const ParamSet	*ps;
+
+	switch (attr)
+	{
+		case SQL_ATTR_PARAMSET_SIZE:
+		case SQL_ATTR_PARAM_BIND_TYPE:
+		case SQL_ATTR_PARAM_BIND_OFFSET_PTR:
+		case SQL_ATTR_PARAM_OPERATION_PTR:
+		case SQL_ATTR_PARAM_STATUS_PTR:
+		case SQL_ATTR_PARAMS_PROCESSED_PTR:
+		case SQL_ATTR_WD_PARAM_STREAM:
+			break;
+		default:
+			return FALSE;
+	}
+	ps = PS_get(stmt, FALSE);
+	switch (attr)
+	{
+		case SQL_ATTR_PARAMSET_SIZE:
+			*(SQLULEN *) value = ps ? ps->paramset_size : 1;
+			break;
+		case SQL_ATTR_PARAM_BIND_TYPE:
+			*(SQLULEN *) value = ps ? ps->bind_type : SQL_PARAM_BIND_BY_COLUMN;
+			break;
+		case SQL_ATTR_PARAM_BIND_OFFSET_PTR:
+			*(SQLPOINTER *) value = ps ? ps->bind_offset_ptr : NULL;
+			break;
+		case SQL_ATTR_PARAM_OPERATION_PTR:
+			*(SQLPOINTER *) value = ps ? ps->operation_ptr : NULL;
+			break;
+		case SQL_ATTR_PARAM_STATUS_PTR:
+			*(SQLPOINTER *) value = ps ? ps->status_ptr : NULL;
+			break;
+		case SQL_ATTR_PARAMS_PROCESSED_PTR:
+			*(SQLPOINTER *) value = ps ? ps->processed_ptr : NULL;
+			break;
+		case SQL_ATTR_WD_PARAM_STREAM:
+			/* still the driver's */
+			*(SQLPOINTER *) value = ps && ps->stream.release ? (SQLPOINTER) &ps->stream : NULL;
+			break;
+	}
+	return TRUE;
+}
+
+void
+PS_set_query(ParamSet *ps, const char *sql, size_t len)
+{
+	int	n;
+
+	clear_put_data(ps);
+	ps->query.assign(sql, len);
+	n = PB_scan_markers(sql, len, NULL, 0);
+	ps->markers.resize(n);
+	if (n > 0)
+		PB_scan_markers(sql, len, &ps->markers[0], n);
+}
+
+SQLSMALLINT
+PS_num_params(ODBCStatement *stmt, ParamSet *ps)
+{
+	/* the markers the lexer found, without asking the server */
+	return (SQLSMALLINT) ps->markers.size();
+}
+
+void
+PS_describe(ODBCStatement *stmt, ParamSet *ps, SQLUSMALLINT ipar,
+	    SQLSMALLINT *sqltype, SQLULEN *column_size,
+	    SQLSMALLINT *decimal_digits, SQLSMALLINT *nullable)
+{
+	SQLSMALLINT	type = SQL_WVARCHAR, digits = 0;
+	SQLULEN		size = UNBOUNDED_COLUMN_SIZE;
+
+	if (ipar < 1 || ipar > PS_num_params(stmt, ps))
+		throw DriverException("Invalid descriptor index", "07009");
+	if (ipar <= ps->bindings.size() && ps->bindings[ipar - 1].param_type)
+	{
+		/* nothing better than what the application said */
+		const ParamBinding	*b = &ps->bindings[ipar - 1];
+
+		type = b->sqltype;
+		size = b->column_size;
+		digits = b->decimal_digits;
+	}
+
+	if (sqltype)
+		*sqltype = type;
+	if (column_size)
+		*column_size = size;
+	if (decimal_digits)
+		*decimal_digits = digits;
+	if (nullable)
+		*nullable = SQL_NULLABLE_UNKNOWN;
+}
+
+/*
+ *	SQL_ATTR_PARAM_STATUS_PTR and SQL_ATTR_PARAMS_PROCESSED_PTR of an
+ *	execution, published when it ends whichever way it ends.
+ */
+class ParamStatus
+{
+public:
+	ParamStatus(ParamSet *ps, SQLULEN nrows)
+		: ps_(ps), status_(nrows, SQL_PARAM_UNUSED) {}
+	~ParamStatus()
+	{
+		SQLULEN	processed = 0, row;
+
+		for (row = 0; row < status_.size(); row++)
+		{
+			if (ps_->status_ptr)
+				ps_->status_ptr[row] = status_[row];
+			if (SQL_PARAM_UNUSED != status_[row])
+				processed++;
+		}
+		if (ps_->processed_ptr)
+			*ps_->processed_ptr = processed;
+	}
+
+	SQLUSMALLINT &operator[](SQLULEN row) { return status_[row]; }
+
+private:
+	ParamSet	*ps_;
+	std::vector<SQLUSMALLINT>	status_;
+};
+
+/* Status of the first 'done' sets of 'rows', executed with these conversion results */
+static void
+set_executed(ParamStatus &status, const std::vector<SQLULEN> &rows,
+	     const std::vector<int> &row_results, int64_t done)
+{
+	int64_t	k;
+
+	for (k = 0; k < done; k++)
+		status[rows[k]] = SQL_ROW_SUCCESS == CC_row_status(row_results[rows[k]]) ?
+			SQL_PARAM_SUCCESS : SQL_PARAM_SUCCESS_WITH_INFO;
+}
+
+/* Report the conversion failures of some sets as warnings, the others went through */
+static void
+report_partial(int result, driver::odbcabstraction::Diagnostics &diagnostics)
+{
+	try
+	{
+		CC_report_result(result, diagnostics);
+	}
+	catch (const DriverException &e)
+	{
+		diagnostics.AddWarning(e.what(), e.GetSqlState(), 0);
+	}
+}
+
+/* Inline the values of batch row 'row' into 'len' bytes of 'sql' and append the text to 'out' */
+static void
+append_inline(const char *sql, size_t len, const size_t *offsets, int nmarkers,
+	      const struct ArrowSchema *schema, const struct ArrowArray *batch,
+	      int64_t row, std::string &out)
+{
+	size_t	textlen;
+	char	*text = PB_inline_literals(sql, len, offsets, nmarkers, schema, batch, row, &textlen);
+
+	if (!text)
+		throw std::bad_alloc();
+	out.append(text, textlen);
+	free(text);
+}
+
+/*
+ *	Execute the statement with the values of the rows of 'batch' sent
+ *	inline: an INSERT of one row of values gets a row per batch row, up to
+ *	MAX_INLINE_STATEMENT bytes of text a statement, other statements run
+ *	once per row.  '*done' counts the rows executed; when an execution
+ *	throws, the rows from '*done' up to '*attempted' are those it had.
+ *	The batch is released once its last row is in the text, so a large
+ *	value is not held twice while the statement goes to the server.
+ */
+static void
+execute_inline(ODBCStatement *stmt, const ParamSet *ps, const struct ArrowSchema *schema,
+	       struct ArrowArray *batch, int64_t *done, int64_t *attempted)
+{
+	const char	*sql = ps->query.data();
+	size_t		len = ps->query.size(), nmarkers = ps->markers.size(), begin, end, k;
+	int64_t		length = batch->length, row;
+	BOOL		tuples = length > 1 &&
+		PB_values_tuple(sql, len, &ps->markers[0], (int) nmarkers, &begin, &end);
+	std::vector<size_t>	offsets(ps->markers);
+
+	if (tuples)
+		for (k = 0; k < nmarkers; k++)
+			offsets[k] -= begin;
+	MYLOG(DETAIL_LOG_LEVEL, "parameters sent inline for stmt=%p, " FORMAT_LEN " sets\n", stmt, (SQLLEN) length);
+	for (*done = *attempted = 0; *done < length; *done = *attempted)
+	{
+		std::string	text;
+
+		if (tuples)
+		{
+			text.assign(sql, begin);
+			for (row = *done; row < length && (row == *done || text.size() < MAX_INLINE_STATEMENT); row++)
+			{
+				if (row > *done)
+					text += ", ";
+				append_inline(sql + begin, end - begin, &offsets[0], (int) nmarkers,
+					      schema, batch, row, text);
+			}
+			text.append(sql + end, len - end);
+		}
+		else
+		{
+			row = *done + 1;
+			append_inline(sql, len, &offsets[0], (int) nmarkers, schema, batch, *done, text);
+		}
+		*attempted = row;
+		if (length == row)
+			batch->release(batch);
+		stmt->ExecuteDirect(text);
+	}
+}
+
+static void
+stream_error(struct ArrowArrayStream *stream)
+{
+	const char	*msg = stream->get_last_error ? stream->get_last_error(stream) : NULL;
+
+	throw DriverException(msg ? msg : "Error reading the parameter stream", "HY000");
+}
+
+/* Execute the statement once per batch of the parameter stream */
+static void
+execute_stream(ODBCStatement *stmt, ParamSet *ps)
+{
+	struct ArrowArrayStream	stream = ps->stream;
+	struct ArrowSchema	schema;
+	struct ArrowArray	batch;
+	int64_t		done, attempted;
+
+	/* the stream serves one execution */
+	ps->stream.release = NULL;
+	StreamGuard	stream_guard(&stream);
+
+	/* every batch of a stream has its schema */
+	schema.release = NULL;
+	ArrowGuard	schema_guard(&schema, NULL);
+	if (0 != stream.get_schema(&stream, &schema))
+		stream_error(&stream);
+	if (schema.n_children < (int64_t) ps->markers.size())
+		throw DriverException("COUNT field incorrect", "07002");
+	if (ps->markers.empty())
+		throw DriverException("The statement has no parameter markers", "07002");
+	if (!PB_can_inline(&schema))
+		throw DriverException("Restricted data type attribute violation", "07006");
+	if (!PB_zones_known(&schema))
+		throw DriverException("Timestamp time zone not supported", "HYC00");
+
+	for (;;)
+	{
+		batch.release = NULL;
+		ArrowGuard	batch_guard(NULL, &batch);
+
+		if (0 != stream.get_next(&stream, &batch))
+			stream_error(&stream);
+		if (!batch.release)
+			break;
+		if (batch.length > 0)
+			execute_inline(stmt, ps, &schema, &batch, &done, &attempted);
+	}
+}
+
+/* Convert the parameter sets of 'layout', with the values put at execution time, and execute */
+static void
+execute_sets(ODBCStatement *stmt, ParamSet *ps, const ParamLayout *layout)
+{
+	size_t		nmarkers = ps->markers.size(), k;
+	struct ArrowSchema	schema;
+	struct ArrowArray	batch;
+	int		result;
+	int64_t		done = 0, attempted = 0;
+	SQLULEN		row;
+	std::vector<int>	row_results(layout->nrows);
+	std::vector<SQLULEN>	rows;	/* the parameter set of each batch row */
+	ParamStatus	status(ps, layout->nrows);
+
+	result = PB_build_batch(&ps->bindings[0], (int) nmarkers, layout,
+				ps->put_data.empty() ? NULL : &ps->put_data[0],
+				&schema, &batch, &row_results[0]);
+	ArrowGuard	guard(&schema, &batch);
+
+	for (row = 0; row < layout->nrows; row++)
+	{
+		if (layout->operations && SQL_PARAM_IGNORE == layout->operations[row])
+			continue;
+		if (SQL_ROW_ERROR == CC_row_status(row_results[row]))
+			status[row] = SQL_PARAM_ERROR;
+		else
+			rows.push_back(row);
+	}
+	if (rows.empty() || 1 == layout->nrows)
+		CC_report_result(result, stmt->GetDiagnostics());
+	else
+		report_partial(result, stmt->GetDiagnostics());
+	if (rows.empty())
+		return;
+
+	try
+	{
+		execute_inline(stmt, ps, &schema, &batch, &done, &attempted);
+	}
+	catch (...)
+	{
+		set_executed(status, rows, row_results, done);
+		for (k = done; k < (size_t) attempted; k++)
+			status[rows[k]] = SQL_PARAM_ERROR;
+		throw;
+	}
+	set_executed(status, rows, row_results, done);
+}
+
+BOOL
+PS_execute(ODBCStatement *stmt, ParamSet *ps, RETCODE *ret)
+{
+	size_t		nmarkers = ps->markers.size(), k;
+	ParamLayout	layout;
+	SQLULEN		row;
+
+	/* a new execution abandons one waiting for data */
+	clear_put_data(ps);
+	*ret = SQL_SUCCESS;
+	if (ps->stream.release)
+	{
+		execute_stream(stmt, ps);
+		return TRUE;
+	}
+	if (0 == nmarkers)
+		return FALSE;
+	if (ps->bindings.size() < nmarkers)
+		throw DriverException("COUNT field incorrect", "07002");
+	layout.nrows = ps->paramset_size;
+	layout.bind_type = ps->bind_type;
+	layout.bind_offset = ps->bind_offset_ptr ? (SQLLEN) *ps->bind_offset_ptr : 0;
+	layout.operations = ps->operation_ptr;
+	for (k = 0; k < nmarkers; k++)
+		if (!ps->bindings[k].param_type)
+			throw DriverException("COUNT field incorrect", "07002");
+
+	for (row = 0; row < layout.nrows; row++)
+	{
+		if (layout.operations && SQL_PARAM_IGNORE == layout.operations[row])
+			continue;
+		for (k = 0; k < nmarkers; k++)
+		{
+			if (!PB_is_data_at_exec(&ps->bindings[k], &layout, row))
+				continue;
+			if (ps->put_data.empty())
+				ps->put_data.resize(layout.nrows * nmarkers, NULL);
+			ps->put_data[row * nmarkers + k] = PB_putdata_create(&ps->bindings[k], &layout, row);
+		}
+	}
+	if (!ps->put_data.empty())
+	{
+		ps->need_data = TRUE;
+		ps->exec_layout = layout;
+		ps->next_put = 0;
+		*ret = SQL_NEED_DATA;
+		return TRUE;
+	}
+	execute_sets(stmt, ps, &layout);
+	return TRUE;
+}
+
+RETCODE
+PS_param_data(ODBCStatement *stmt, ParamSet *ps, PTR *token)
+{
+	size_t	n = ps->put_data.size();
+
+	if (!ps->need_data)
+		throw DriverException("Function sequence error", "HY010");
+	ps->current = NULL;
+	while (ps->next_put < n && !ps->put_data[ps->next_put])
+		ps->next_put++;
+	if (ps->next_put < n)
+	{
+		ps->current = ps->put_data[ps->next_put];
+		ps->current_ctype = ps->bindings[ps->next_put % ps->markers.size()].ctype;
+		ps->next_put++;
+		if (token)
+			*token = PB_putdata_token(ps->current);
+		return SQL_NEED_DATA;
+	}
+	return SQL_SUCCESS;
+}
+
+RETCODE
+PS_execute_data(ODBCStatement *stmt, ParamSet *ps)
+{
+	/* SQLParamData has not yet reported every value in */
+	if (!ps->need_data || ps->current || ps->next_put < ps->put_data.size())
+		throw DriverException("Function sequence error", "HY010");
+	try
+	{
+		execute_sets(stmt, ps, &ps->exec_layout);
+	}
+	catch (...)
+	{
+		clear_put_data(ps);
+		throw;
+	}
+	clear_put_data(ps);
+	return SQL_SUCCESS;
+}
+
+void
+PS_put_data(ODBCStatement *stmt, ParamSet *ps, PTR data, SQLLEN len)
+{
+	PutData	*pd = ps->current;
+	BOOL	pieces = SQL_C_CHAR == ps->current_ctype || SQL_C_WCHAR == ps->current_ctype ||
+			 SQL_C_BINARY == ps->current_ctype;
+	int	result;
+
+	if (!pd)
+		throw DriverException("Function sequence error", "HY010");
+	if (PB_putdata_started(pd))
+	{
+		if (SQL_NULL_DATA == len || PB_putdata_is_null(pd))
+			throw DriverException("Attempt to concatenate a null value", "HY020");
+		if (!pieces)
+			throw DriverException("Non-character and non-binary data sent in pieces", "HY019");
+	}
+	if (!data && SQL_NULL_DATA != len && (0 != len || !pieces))
+		throw DriverException("Invalid use of null pointer", "HY009");
+	if (len < 0 && SQL_NULL_DATA != len && !(SQL_NTS == len && SQL_C_BINARY != ps->current_ctype))
+		throw DriverException("Invalid string or buffer length", "HY090");
+
+	result = PB_putdata_append(pd, data, len);
+	CC_report_result(result, stmt->GetDiagnostics());
+}
@@ -0,0 +1,93 @@
+/* File:			paramset.h
+ *
+ * Description:		See "paramset.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __PARAMSET_H__
+#define __PARAMSET_H__
+
+#include "paramconv.h"
+
+namespace ODBC
+{
+  class ODBCStatement;
+}
+
+typedef struct ParamSet_ ParamSet;
+
+/*
+ *	The parameter state of a statement, kept in its extension: its bound
+ *	parameters and the text of the statement they go with.  It is created
+ *	on first use when 'create' is TRUE, otherwise NULL is returned for a
+ *	statement that has none, and freed by PS_drop() with the statement
+ *	handle.
+ */
+ParamSet	*PS_get(ODBC::ODBCStatement *stmt, BOOL create);
+void		PS_drop(ODBC::ODBCStatement *stmt);
+
+/* SQLBindParameter; 'ipar' is 1 based.  Throws DriverException. */
+void	PS_bind(ParamSet *ps, SQLUSMALLINT ipar, SQLSMALLINT param_type,
+		SQLSMALLINT ctype, SQLSMALLINT sqltype, SQLULEN column_size,
+		SQLSMALLINT decimal_digits, PTR buffer, SQLLEN buflen, SQLLEN *indicator);
+/* SQLFreeStmt(SQL_RESET_PARAMS) */
+void	PS_unbind(ParamSet *ps);
+
+/*
+ *	SQLSetStmtAttr and SQLGetStmtAttr of the parameter array attributes
+ *	(SQL_ATTR_PARAMSET_SIZE, SQL_ATTR_PARAM_BIND_TYPE and the _PTR ones)
+ *	and of SQL_ATTR_WD_PARAM_STREAM.
+ *	Return FALSE, doing nothing, for any other attribute.  Throws
+ *	DriverException.
+ */
+BOOL	PS_set_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+BOOL	PS_get_attr(ODBC::ODBCStatement *stmt, SQLINTEGER attr, PTR value);
+
+/*
+ *	Record the text of the statement being prepared or executed directly,
+ *	finding its parameter markers.
+ */
+void	PS_set_query(ParamSet *ps, const char *sql, size_t len);
+
+/*
+ *	SQLNumParams and SQLDescribeParam of the current statement text.  The
+ *	markers are counted in the text and described from their bindings.
+ */
+SQLSMALLINT	PS_num_params(ODBC::ODBCStatement *stmt, ParamSet *ps);
+void	PS_describe(ODBC::ODBCStatement *stmt, ParamSet *ps, SQLUSMALLINT ipar,
+		SQLSMALLINT *sqltype, SQLULEN *column_size,
+		SQLSMALLINT *decimal_digits, SQLSMALLINT *nullable);
+
+/*
+ *	Execute the current statement with its bound parameter values, every
+ *	set of the parameter arrays, filling SQL_ATTR_PARAM_STATUS_PTR and
+ *	SQL_ATTR_PARAMS_PROCESSED_PTR.  Sets that fail to convert are
+ *	reported as warnings while others go through.  A parameter stream,
+ *	when one was set, is used up instead of the bound parameters.
+ *
+ *	Only an INSERT of one row of values takes many sets per round trip,
+ *	as a multi-row INSERT; any other statement makes one round trip per
+ *	set, the driver having no way to bind a batch of values to its
+ *	prepared statement.
+ *
+ *	'*ret' becomes SQL_NEED_DATA when values are to be supplied at
+ *	execution time; the statement then runs from the PS_param_data() call
+ *	after the last of them.  Returns FALSE, doing nothing, when the
+ *	statement has no parameter markers and the caller executes it as
+ *	usual.  Throws DriverException.
+ */
+BOOL	PS_execute(ODBC::ODBCStatement *stmt, ParamSet *ps, RETCODE *ret);
+
+/*
+ *	SQLParamData and SQLPutData.  PS_param_data() returns SQL_NEED_DATA
+ *	with the token of the next value to supply, or SQL_SUCCESS once every
+ *	value is in, the statement then run by PS_execute_data().  Throw
+ *	DriverException.
+ */
+RETCODE	PS_param_data(ODBC::ODBCStatement *stmt, ParamSet *ps, PTR *token);
+RETCODE	PS_execute_data(ODBC::ODBCStatement *stmt, ParamSet *ps);
+void	PS_put_data(ODBC::ODBCStatement *stmt, ParamSet *ps, PTR data, SQLLEN len);
+
+#endif /* __PARAMSET_H__ */
@@ -0,0 +1,208 @@
+/*-------
+ * Module:			resinfo.cc
+ *
+ * Description:		This module contains the description of the result
+ *					columns of statements as SQLNumResultCols,
+ *					SQLDescribeCol and SQLColAttribute report them.
+ *
+ *					Every execution fills the IRD anew, and applications
+ *					describe the result again after each one.  The
+ *					description derived from the IRD, with the names
+ *					converted for the wide functions, is kept with a
+ *					fingerprint of the IRD fields it came from.  When a
+ *					statement is executed again and the fingerprint has not
+ *					changed, the kept description is used as it is; the IRD
+ *					is hashed once per execution, on the first call that
+ *					describes the result.
+ *
+ *					After SQLPrepare the IRD holds the dataset schema the
+ *					server returned with the prepared statement, so the
+ *					result is described without executing anything.  When
+ *					the server returned no schema, the statement is
+ *					described with no columns until it is executed.
+ *
+ * Classes:			ResultInfo
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "resinfo.h"
+#include "extension.h"
+#include "unicode_support.h"
+#include "mylog.h"
+
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCStatement.h>
+#include <odbcabstraction/odbc_impl/ODBCDescriptor.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::DescriptorRecord;
+using ODBC::ODBCStatement;
+
+struct ResultInfo_
+{
+	BOOL			stale;		/* check against the IRD before use */
+	BOOL			built;
+	uint64_t		fingerprint;
+	std::vector<std::vector<SQLWCHAR> >	wnames;
+	std::vector<ResultColumn>	columns;
+};
+
+/* 64 bit FNV-1a */
+#define	FNV_OFFSET	UINT64_C(0xcbf29ce484222325)
+#define	FNV_PRIME	UINT64_C(0x100000001b3)
+
+static inline uint64_t
+hash_bytes(uint64_t h, const void *p, size_t len)
+{
+	const UCHAR	*s = (const UCHAR *) p;
+	size_t		i;
+
+	for (i = 0; i < len; i++)
+		h = (h ^ s[i]) * FNV_PRIME;
+	return h;
+}
+
+#define	HASH_FIELD(h, field)	hash_bytes((h), &(field), sizeof(field))
+
+/* Fingerprint of the IRD fields the description is made of */
+static uint64_t
+fingerprint(const std::vector<DescriptorRecord> &records)
+{
+	uint64_t	h = FNV_OFFSET;
+	size_t		n = records.size(), i;
+
+	h = HASH_FIELD(h, n);
+	for (i = 0; i < n; i++)
+	{
+		const DescriptorRecord	&r = records[i];
+		size_t		len;
+
+		len = r.m_name.size();
+		h = HASH_FIELD(h, len);
+		h = hash_bytes(h, r.m_name.data(), len);
+		h = HASH_FIELD(h, r.m_conciseType);
+		h = HASH_FIELD(h, r.m_length);
+		h = HASH_FIELD(h, r.m_scale);
+		h = HASH_FIELD(h, r.m_nullable);
+	}
+	return h;
+}
+
+static void
+build(ResultInfo *ri, const std::vector<DescriptorRecord> &records)
+{
+	size_t	n = records.size(), i;
+
+	ri->wnames.resize(n);
+	ri->columns.resize(n);
+	for (i = 0; i < n; i++)
+	{
+		const DescriptorRecord	&r = records[i];
+		ResultColumn	*col = &ri->columns[i];
+		SQLULEN		wlen;
+
+		wlen = utf8_to_ucs2(r.m_name.c_str(), (SQLLEN) r.m_name.size(), NULL, 0);
+		if ((SQLULEN) -1 == wlen)
+			wlen = 0;
+		ri->wnames[i].assign(wlen + 1, 0);
+		utf8_to_ucs2(r.m_name.c_str(), (SQLLEN) r.m_name.size(), &ri->wnames[i][0], wlen + 1);
+
+		col->wname = &ri->wnames[i][0];
+		col->wname_len = wlen;
+		col->sqltype = r.m_conciseType;
+		col->column_size = r.m_length;
+		col->decimal_digits = r.m_scale;
+		col->nullable = r.m_nullable;
+	}
+}
+
+/* The description kept for 'stmt', made when there is none */
+static ResultInfo *
+info_of(ODBCStatement *stmt)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+	ResultInfo	*ri;
+
+	if (ext->result)
+		return ext->result;
+	ri = new ResultInfo;
+	ri->stale = TRUE;
+	ri->built = FALSE;
+	ri->fingerprint = 0;
+	ext->result = ri;
+	return ri;
+}
+
+/* The description of the current result of 'stmt', checked against its IRD when stale */
+static ResultInfo *
+current(ODBCStatement *stmt)
+{
+	ResultInfo	*ri = info_of(stmt);
+
+	if (ri->stale)
+	{
+		const std::vector<DescriptorRecord>	&records = stmt->GetIRD()->GetRecords();
+		uint64_t	fp = fingerprint(records);
+
+		if (!ri->built || fp != ri->fingerprint)
+		{
+			MYLOG(DETAIL_LOG_LEVEL, "%p: " FORMAT_SIZE_T " columns described\n", stmt, records.size());
+			build(ri, records);
+			ri->fingerprint = fp;
+			ri->built = TRUE;
+		}
+		ri->stale = FALSE;
+	}
+	return ri;
+}
+
+void
+RI_stale(ODBCStatement *stmt)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+
+	if (ext->result)
+		ext->result->stale = TRUE;
+}
+
+void
+RI_drop(ODBCStatement *stmt)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+
+	delete ext->result;
+	ext->result = NULL;
+}
+
+SQLSMALLINT
+RI_num_cols(ODBCStatement *stmt)
+{
+	return (SQLSMALLINT) current(stmt)->columns.size();
+}
+
+const ResultColumn *
+RI_column(ODBCStatement *stmt, SQLUSMALLINT icol)
+{
+	ResultInfo	*ri = current(stmt);
+
+	if (icol < 1 || icol > ri->columns.size())
+		throw DriverException("Invalid descriptor index", "07009");
+	return &ri->columns[icol - 1];
+}
+
+const DescriptorRecord *
+RI_record(ODBCStatement *stmt, SQLUSMALLINT icol)
+{
+	const std::vector<DescriptorRecord>	&records = stmt->GetIRD()->GetRecords();
+
+	if (icol < 1 || icol > records.size())
+		throw DriverException("Invalid descriptor index", "07009");
+	return &records[icol - 1];
+}
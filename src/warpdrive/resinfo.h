@@ -0,0 +1,56 @@
+/* File:			resinfo.h
+ *
+ * Description:		See "resinfo.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __RESINFO_H__
+#define __RESINFO_H__
+
+#include "wdodbc.h"
+
+namespace ODBC
+{
+  class ODBCStatement;
+  struct DescriptorRecord;
+}
+
+/* A result column as SQLDescribeCol reports it */
+typedef struct
+{
+	const SQLWCHAR	*wname;		/* the name for the wide functions */
+	size_t		wname_len;	/* in SQLWCHARs */
+	SQLSMALLINT	sqltype;
+	SQLULEN		column_size;
+	SQLSMALLINT	decimal_digits;
+	SQLSMALLINT	nullable;
+} ResultColumn;
+
+/*
+ *	The statement may have a new result, so the description kept for it
+ *	is checked against the IRD on its next use.  Called by every function
+ *	that executes, prepares or opens a catalog result.  RI_drop() forgets
+ *	the statement.
+ */
+void	RI_stale(ODBC::ODBCStatement *stmt);
+
+void	RI_drop(ODBC::ODBCStatement *stmt);
+
+/* SQLNumResultCols */
+SQLSMALLINT	RI_num_cols(ODBC::ODBCStatement *stmt);
+
+/*
+ *	Column 'icol', 1 based, of the current result.  It stays valid until
+ *	the statement is executed again or freed.  Throws DriverException.
+ */
+const ResultColumn	*RI_column(ODBC::ODBCStatement *stmt, SQLUSMALLINT icol);
+
+/*
+ *	The IRD record of column 'icol', 1 based, of the current result.
+ *	Throws DriverException.
+ */
+const ODBC::DescriptorRecord	*RI_record(ODBC::ODBCStatement *stmt, SQLUSMALLINT icol);
+
+#endif /* __RESINFO_H__ */
@@ -30,6 +30,8 @@
 #include "qresult.h"
 #include "convert.h"
 #include "wdtypes.h"
+#include "resinfo.h"
+#include "stmtbatch.h"
 
 #include <stdio.h>
 #include <limits.h>
@@ -121,9 +123,8 @@ WD_NumResultCols(HSTMT hstmt,
 {
   CSTR func = "WD_NumResultCols";
   ODBCStatement* stmt = reinterpret_cast<ODBCStatement*>(hstmt);
-  const std::vector<DescriptorRecord>& records = stmt->GetIRD()->GetRecords();
 
-  GetAttribute<SQLSMALLINT,size_t>(static_cast<SQLSMALLINT>(records.size()), pccol, sizeof(SQLSMALLINT), nullptr);
+  GetAttribute<SQLSMALLINT,size_t>(RI_num_cols(stmt), pccol, sizeof(SQLSMALLINT), nullptr);
   return SQL_SUCCESS;
 }
 
@@ -151,19 +152,21 @@ WD_DescribeCol(HSTMT hstmt,
   }
 
   ODBCStatement* stmt = reinterpret_cast<ODBCStatement*>(hstmt);
-  const std::vector<DescriptorRecord>& records = stmt->GetIRD()->GetRecords();
-
-  SQLUSMALLINT zeroBasedIndex = icol - 1;
-  const DescriptorRecord& record = records[zeroBasedIndex];
-  SQLSMALLINT totalColumnNameLen;
-  SQLRETURN ret = GetAttributeUTF8(record.m_name, szColName, cbColNameMax, &totalColumnNameLen, stmt->GetDiagnostics());
-  if (pcbColName) {
-    *pcbColName = totalColumnNameLen;
+  const ResultColumn* column = RI_column(stmt, icol);
+  SQLRETURN ret = SQL_SUCCESS;
+
+  if (szColName || pcbColName) {
+    const DescriptorRecord& record = *RI_record(stmt, icol);
+    SQLSMALLINT totalColumnNameLen;
+    ret = GetAttributeUTF8(record.m_name, szColName, cbColNameMax, &totalColumnNameLen, stmt->GetDiagnostics());
+    if (pcbColName) {
+      *pcbColName = totalColumnNameLen;
+    }
   }
-  GetAttribute<SQLSMALLINT, size_t>(record.m_conciseType, pfSqlType, sizeof(SQLUSMALLINT), nullptr);
-  GetAttribute<SQLULEN, size_t>(record.m_length, pcbColDef, sizeof(SQLULEN), nullptr);
-  GetAttribute<SQLSMALLINT, size_t>(record.m_scale, pibScale, sizeof(SQLSMALLINT), nullptr);
-  GetAttribute<SQLSMALLINT, size_t>(record.m_nullable, pfNullable, sizeof(SQLSMALLINT), nullptr);
+  GetAttribute<SQLSMALLINT, size_t>(column->sqltype, pfSqlType, sizeof(SQLUSMALLINT), nullptr);
+  GetAttribute<SQLULEN, size_t>(column->column_size, pcbColDef, sizeof(SQLULEN), nullptr);
+  GetAttribute<SQLSMALLINT, size_t>(column->decimal_digits, pibScale, sizeof(SQLSMALLINT), nullptr);
+  GetAttribute<SQLSMALLINT, size_t>(column->nullable, pfNullable, sizeof(SQLSMALLINT), nullptr);
   
   return ret;
 }
@@ -190,17 +193,15 @@ WD_ColAttributes(HSTMT hstmt,
 
 	
   ODBCStatement* stmt = reinterpret_cast<ODBCStatement*>(hstmt);
-  const std::vector<DescriptorRecord>& records = stmt->GetIRD()->GetRecords();
   
   if (fDescType == SQL_DESC_COUNT) {
     if (pfDesc) {
-	  *pfDesc = static_cast<SQLLEN>(records.size());
+	  *pfDesc = static_cast<SQLLEN>(RI_num_cols(stmt));
 	}
 	return SQL_SUCCESS;
   }
 
-  SQLUSMALLINT zeroBasedIndex = icol - 1;
-  const DescriptorRecord& record = records[zeroBasedIndex];
+  const DescriptorRecord& record = *RI_record(stmt, icol);
 
   SQLLEN recordNumericValue = 0;
   const std::string* recordStrValue = nullptr;
@@ -536,68 +537,23 @@ MYLOG(DETAIL_LOG_LEVEL, "RETURN_EOF\n"); \
 
 /*
  *		This determines whether there are more results sets available for
- *		the "hstmt".
+ *		the "hstmt": the next statement of a batch SQLExecDirect was given
+ *		is executed, its result taking the place of the current one.
  */
-/* CC: return SQL_NO_DATA_FOUND since we do not support multiple result sets */
 RETCODE		SQL_API
 WD_MoreResults(HSTMT hstmt)
 {
-	StatementClass	*stmt = (StatementClass *) hstmt;
-	QResultClass	*res;
-	RETCODE		ret = SQL_SUCCESS;
+	ODBCStatement	*stmt = reinterpret_cast<ODBCStatement*>(hstmt);
+	std::string	query;
+	RETCODE		ret;
 
 	MYLOG(0, "entering...\n");
-	res = SC_get_Curres(stmt);
-	if (res)
-	{
-		res = QR_nextr(res);
-		SC_set_Curres(stmt, res);
-	}
-	if (res)
-	{
-		SQLSMALLINT	num_p;
-		int errnum = 0, curerr;
-
-		if (stmt->multi_statement < 0)
-			WD_NumParams(stmt, &num_p);
-		if (stmt->multi_statement > 0)
-		{
-			const char *cmdstr;
-
-			SC_initialize_cols_info(stmt, FALSE, TRUE);
-			stmt->statement_type = STMT_TYPE_UNKNOWN;
-			if (cmdstr = QR_get_command(res), NULL != cmdstr)
-				stmt->statement_type = statement_type(cmdstr);
-			stmt->join_info = 0;
-			SC_clear_parse_method(stmt);
-		}
-		stmt->diag_row_count = res->recent_processed_row_count;
-		SC_set_rowset_start(stmt, -1, FALSE);
-		stmt->currTuple = -1;
-
-		if (!QR_command_maybe_successful(res))
-		{
-			ret = SQL_ERROR;
-			errnum = STMT_EXEC_ERROR;
-		}
-		else if (NULL != QR_get_notice(res))
-		{
-			ret = SQL_SUCCESS_WITH_INFO;
-			errnum = STMT_INFO_ONLY;
-		}
-		if (0 != errnum)
-		{
-			curerr = SC_get_errornumber(stmt);
-			if (0 == curerr ||
-			    (0 > curerr && errnum > 0))
-				SC_set_errornumber(stmt, errnum);
-		}
-	}
+	stmt->closeCursor(true);
+	if (SB_next(stmt, query))
+		ret = WD_ExecDirect(hstmt, (const SQLCHAR *) query.data(),
+				(SQLINTEGER) query.size(), PODBC_BATCH_MEMBER);
 	else
-	{
-		WD_FreeStmt(hstmt, SQL_CLOSE);
 		ret = SQL_NO_DATA_FOUND;
-	}
 	MYLOG(0, "leaving %d\n", ret);
 	return ret;
 }
@@ -0,0 +1,58 @@
+/*-------
+ * Module:			sqllexer.cc
+ *
+ * Description:		This module contains the lexical rules the driver reads
+ *					statement texts with, before anything reaches the
+ *					server: to find their parameter markers, to split
+ *					batches and to rewrite escapes.
+ *
+ *					They are those of the server's SQL parser: a doubled
+ *					quote stays inside a string literal ('...') or a quoted
+ *					identifier ("..." or `...`), and a backslash is an
+ *					ordinary character.  Comments run from -- or // to the
+ *					end of the line, or are C style and do not nest.
+ *
+ * Classes:			none
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "sqllexer.h"
+
+size_t
+LX_skip(const char *sql, size_t len, size_t i)
+{
+	char	c = sql[i];
+
+	if (LITERAL_QUOTE == c || IDENTIFIER_QUOTE == c || '`' == c)
+	{
+		/* a doubled quote stays inside */
+		for (i++; i < len; i++)
+		{
+			if (sql[i] != c)
+				continue;
+			if (i + 1 < len && sql[i + 1] == c)
+				i++;
+			else
+				break;
+		}
+		return i < len ? i + 1 : len;
+	}
+	if (('-' == c || '/' == c) && i + 1 < len && c == sql[i + 1])
+	{
+		while (i < len && '\n' != sql[i])
+			i++;
+		return i;
+	}
+	if ('/' == c && i + 1 < len && '*' == sql[i + 1])
+	{
+		for (i += 2; i + 1 < len && !('*' == sql[i] && '/' == sql[i + 1]); i++)
+			;
+		return i + 2 <= len ? i + 2 : len;
+	}
+	return i;
+}
@@ -0,0 +1,21 @@
+/* File:			sqllexer.h
+ *
+ * Description:		See "sqllexer.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __SQLLEXER_H__
+#define __SQLLEXER_H__
+
+#include "wdodbc.h"
+
+/*
+ *	Index past the string literal, quoted identifier or comment starting
+ *	at 'i' of 'len' bytes of 'sql', 'len' at most, or 'i' itself when none
+ *	starts there.
+ */
+size_t	LX_skip(const char *sql, size_t len, size_t i);
+
+#endif /* __SQLLEXER_H__ */
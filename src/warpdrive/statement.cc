@@ -16,6 +16,7 @@
 #include "wdodbc.h"
 #include <memory>
 #include <new>
+#include <vector>
 #ifdef	WIN_MULTITHREAD_SUPPORT
 #ifndef	_WIN32_WINNT
 #define	_WIN32_WINNT	0x0400
@@ -31,6 +32,12 @@
 #include "qresult.h"
 #include "convert.h"
 #include "environ.h"
+#include "paramset.h"
+#include "resinfo.h"
+#include "asyncexec.h"
+#include "stmtbatch.h"
+#include "odbcescape.h"
+#include "extension.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -180,6 +187,30 @@ static const struct
 	}
 };
 
+/* Forget what the modules keep for 'stmt', which is being freed */
+static void
+forget_statement(ODBCStatement *stmt)
+{
+	AE_detach(stmt);
+	SB_discard(stmt);
+	PS_drop(stmt);
+	RI_drop(stmt);
+	EX_forget_stmt(stmt);
+}
+
+void
+SC_forget_statements(ODBCConnection *conn)
+{
+	std::vector<ODBCStatement *>	stmts;
+
+	EX_statements(conn, stmts);
+	for (size_t i = 0; i < stmts.size(); i++)
+	{
+		MYLOG(0, "forgetting stmt=%p of conn=%p\n", stmts[i], conn);
+		forget_statement(stmts[i]);
+	}
+}
+
 static QResultClass *libpq_bind_and_exec(StatementClass *stmt);
 static void SC_set_errorinfo(StatementClass *self, QResultClass *res, int errkind);
 static void SC_set_error_if_not_set(StatementClass *self, int errornumber, const char *errmsg, const char *func);
@@ -204,6 +235,8 @@ WD_AllocStmt(HDBC hdbc,
     std::shared_ptr<ODBCStatement> stmt = conn->createStatement();
  	MYLOG(0, "**** : hdbc = %p, stmt = %p\n", hdbc, stmt.get());
 
+    EX_attach(conn, stmt.get());
+    AE_attach(conn, stmt.get());
     *phstmt = stmt.get();
 	return SQL_SUCCESS;
 }
@@ -222,6 +255,7 @@ WD_FreeStmt(HSTMT hstmt,
 		// Special case. Can't use automated error handling because inspecting the diagnostics
 		// inspects an already destroyed diagnostics object.
 		try {
+			forget_statement(stmt);
 			stmt->GetDiagnostics().Clear();
 			stmt->releaseStatement();
 			return SQL_SUCCESS;
@@ -251,6 +285,7 @@ WD_FreeStmt(HSTMT hstmt,
 	}
 	else if (fOption == SQL_CLOSE)
 	{
+          SB_discard(stmt);
           try {
             stmt->closeCursor(true);
           } catch (const std::exception& ex) {
@@ -264,7 +299,10 @@ WD_FreeStmt(HSTMT hstmt,
           stmt->GetDiagnostics().Clear();
 	}
 	else if (fOption == SQL_RESET_PARAMS) {
-		// Do nothing, since parameters are unsupported.
+		ParamSet *ps = PS_get(stmt, FALSE);
+
+		if (ps)
+			PS_unbind(ps);
 	}
 	else
 	{
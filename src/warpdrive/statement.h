@@ -563,6 +563,17 @@ RETCODE		DiscardStatementSvp(StatementClass *self, RETCODE, BOOL errorOnly);
 QResultClass *ParseAndDescribeWithLibpq(StatementClass *stmt, const char *plan_name, const char *query_p, Int2 num_params, const char *comment, QResultClass *res);
 BOOL	CheckPgClassInfo(StatementClass *);
 
+namespace ODBC
+{
+  class ODBCConnection;
+}
+
+/*
+ *	Forget what the modules keep for the statements of 'conn', which
+ *	disconnecting or freeing the connection frees with it.
+ */
+void	SC_forget_statements(ODBC::ODBCConnection *conn);
+
 /*
  *	Macros to convert global index <-> relative index in resultset/rowset
  */
@@ -0,0 +1,126 @@
+/*-------
+ * Module:			stmtbatch.cc
+ *
+ * Description:		This module contains the batches of statements
+ *					SQLExecDirect takes, separated by semicolons, and whose
+ *					results SQLMoreResults moves through.
+ *
+ *					The text is split where a semicolon stands outside
+ *					string literals, quoted identifiers and comments.  The
+ *					first statement is executed by SQLExecDirect and each
+ *					of the others by the SQLMoreResults call that comes to
+ *					it, so that its result set, or its row count, takes the
+ *					place of the one before on the statement handle.  The
+ *					statements are not pipelined: the next one is sent only
+ *					when the application moves to it, as the statement
+ *					handle holds one result at a time.  Parameters are
+ *					bound to a single statement, so a batch with markers is
+ *					rejected.
+ *
+ * Classes:			Batch
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "stmtbatch.h"
+#include "extension.h"
+#include "paramconv.h"
+#include "wdapifunc.h"
+#include "mylog.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <odbcabstraction/exceptions.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCStatement;
+
+struct Batch_
+{
+	std::deque<std::string>	rest;		/* not executed yet, in order */
+};
+
+void
+SB_start(ODBCStatement *stmt, std::string &query)
+{
+	StatementExt	*ext;
+	Batch	*batch;
+	int	count, i;
+
+	SB_discard(stmt);
+	count = PB_split_statements(query.data(), query.size(), NULL, NULL, 0);
+	if (count < 2)
+		return;
+	if (PB_scan_markers(query.data(), query.size(), NULL, 0) > 0)
+		throw DriverException("Batches with parameter markers are not supported", "HYC00");
+
+	std::vector<size_t>	begins(count), ends(count);
+
+	PB_split_statements(query.data(), query.size(), begins.data(), ends.data(), count);
+	batch = new Batch();
+	for (i = 1; i < count; i++)
+		batch->rest.push_back(query.substr(begins[i], ends[i] - begins[i]));
+	query = query.substr(begins[0], ends[0] - begins[0]);
+	MYLOG(0, "batch of %d statements\n", count);
+
+	ext = EX_stmt(stmt);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+	ext->batch = batch;
+}
+
+BOOL
+SB_next(ODBCStatement *stmt, std::string &query)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	if (!ext->batch || ext->batch->rest.empty())
+		return FALSE;
+	query = std::move(ext->batch->rest.front());
+	ext->batch->rest.pop_front();
+	return TRUE;
+}
+
+void
+SB_discard(ODBCStatement *stmt)
+{
+	StatementExt	*ext = EX_stmt(stmt);
+	Batch	*batch;
+
+	{
+		std::lock_guard<std::mutex>	lock(ext->lock);
+
+		batch = ext->batch;
+		ext->batch = NULL;
+	}
+	delete batch;
+}
+
+BOOL
+SB_get_info(SQLUSMALLINT type, PTR value, SQLSMALLINT *len)
+{
+	SQLUINTEGER	ival;
+
+	switch (type)
+	{
+		case SQL_BATCH_SUPPORT:
+			ival = SQL_BS_SELECT_EXPLICIT | SQL_BS_ROW_COUNT_EXPLICIT;
+			break;
+		case SQL_BATCH_ROW_COUNT:
+			ival = SQL_BRC_EXPLICIT;
+			break;
+		default:
+			return FALSE;
+	}
+	if (value)
+		*((SQLUINTEGER *) value) = ival;
+	if (len)
+		*len = sizeof(SQLUINTEGER);
+	return TRUE;
+}
@@ -0,0 +1,48 @@
+/* File:			stmtbatch.h
+ *
+ * Description:		See "stmtbatch.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __STMTBATCH_H__
+#define __STMTBATCH_H__
+
+#include "wdodbc.h"
+
+#include <string>
+
+namespace ODBC
+{
+  class ODBCStatement;
+}
+
+/*
+ *	SQLExecDirect of 'query' on 'stmt': the statements left of an earlier
+ *	batch are discarded, and when 'query' holds several statements, it is
+ *	made the first of them and the others are kept for SB_next().  Throws
+ *	DriverException for a batch with parameter markers.
+ */
+void	SB_start(ODBC::ODBCStatement *stmt, std::string &query);
+
+/*
+ *	SQLMoreResults: the next statement of the batch of 'stmt' into
+ *	'query'.  FALSE when there is none left.
+ */
+BOOL	SB_next(ODBC::ODBCStatement *stmt, std::string &query);
+
+/*
+ *	Forget the statements of the batch of 'stmt' not executed yet, when
+ *	its cursor is closed, another statement is prepared or executed on it
+ *	or the handle is freed.
+ */
+void	SB_discard(ODBC::ODBCStatement *stmt);
+
+/*
+ *	SQLGetInfo of SQL_BATCH_SUPPORT and SQL_BATCH_ROW_COUNT.  Returns FALSE
+ *	for other types.
+ */
+BOOL	SB_get_info(SQLUSMALLINT type, PTR value, SQLSMALLINT *len);
+
+#endif /* __STMTBATCH_H__ */
@@ -0,0 +1,202 @@
+/*-------
+ * Module:			transact.cc
+ *
+ * Description:		This module contains the manual commit mode of
+ *					connections.
+ *
+ *					With SQL_ATTR_AUTOCOMMIT off the statements of a
+ *					connection run in a Flight SQL transaction, begun on the
+ *					server by the first statement executed after connecting
+ *					or after SQLEndTran committed or rolled back the last,
+ *					so a loader inserting many rows per commit pays for one
+ *					commit on the server rather than one per statement.  A
+ *					connection with no statement run since has nothing open
+ *					and may disconnect.
+ *
+ *					Turning autocommit back on commits the open transaction.
+ *					When the driver cannot run transactions for the server,
+ *					autocommit can still be turned off, the statements then
+ *					committing as they run, but SQLEndTran fails with HYC00
+ *					and SQLGetInfo reports no transaction support.
+ *
+ * Classes:			Transaction
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "transact.h"
+#include "extension.h"
+#include "mylog.h"
+#include "new_driver.h"
+
+#include <mutex>
+
+#include <odbcabstraction/exceptions.h>
+#include <odbcabstraction/odbc_impl/ODBCConnection.h>
+
+using driver::odbcabstraction::DriverException;
+using ODBC::ODBCConnection;
+
+struct Transaction_
+{
+	SQLUINTEGER	autocommit;	/* SQL_AUTOCOMMIT_ON or _OFF */
+	BOOL		connected;
+	BOOL		in_trans;	/* a transaction is open on the server */
+};
+
+static Transaction
+get_state(ODBCConnection *conn)
+{
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+	Transaction	tx = { SQL_AUTOCOMMIT_ON, FALSE, FALSE };
+
+	if (ext->transaction)
+		tx = *ext->transaction;
+	return tx;
+}
+
+static void
+set_state(ODBCConnection *conn, const Transaction &tx)
+{
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	if (!ext->transaction)
+		ext->transaction = new Transaction;
+	*ext->transaction = tx;
+}
+
+BOOL
+TX_set_attr(ODBCConnection *conn, SQLINTEGER attr, PTR value)
+{
+	SQLUINTEGER	autocommit = (SQLUINTEGER) (SQLULEN) value;
+	Transaction	tx;
+
+	if (SQL_ATTR_AUTOCOMMIT != attr)
+		return FALSE;
+	if (SQL_AUTOCOMMIT_ON != autocommit && SQL_AUTOCOMMIT_OFF != autocommit)
+		throw DriverException("Invalid attribute value", "HY024");
+
+	if (SQL_AUTOCOMMIT_OFF == autocommit && !SupportsTransactions(conn))
+		throw DriverException("Transactions are not supported", "HYC00");
+
+	tx = get_state(conn);
+	if (autocommit == tx.autocommit)
+		return TRUE;
+	/* turned off, the transaction is begun by the next statement */
+	if (SQL_AUTOCOMMIT_ON == autocommit && tx.in_trans)
+	{
+		/* the open transaction is committed, as ODBC wants */
+		EndTransaction(conn, true);
+		MYLOG(0, "%p: committed on autocommit\n", conn);
+		tx.in_trans = FALSE;
+	}
+	tx.autocommit = autocommit;
+	set_state(conn, tx);
+	return TRUE;
+}
+
+BOOL
+TX_get_attr(ODBCConnection *conn, SQLINTEGER attr, PTR value)
+{
+	if (SQL_ATTR_AUTOCOMMIT != attr)
+		return FALSE;
+	if (value)
+		*((SQLUINTEGER *) value) = get_state(conn).autocommit;
+	return TRUE;
+}
+
+RETCODE
+TX_end(ODBCConnection *conn, SQLSMALLINT completion)
+{
+	Transaction	tx;
+
+	if (SQL_COMMIT != completion && SQL_ROLLBACK != completion)
+		throw DriverException("Invalid transaction operation code", "HY012");
+
+	tx = get_state(conn);
+	if (SQL_AUTOCOMMIT_OFF != tx.autocommit || !tx.connected || !tx.in_trans)
+		return SQL_SUCCESS;
+	/* a failed commit leaves it open, for the application to roll back */
+	EndTransaction(conn, SQL_COMMIT == completion);
+	MYLOG(0, "%p: %s\n", conn, SQL_COMMIT == completion ? "committed" : "rolled back");
+	tx.in_trans = FALSE;
+	set_state(conn, tx);
+	return SQL_SUCCESS;
+}
+
+void
+TX_work(ODBCConnection *conn)
+{
+	Transaction	tx = get_state(conn);
+
+	if (SQL_AUTOCOMMIT_OFF != tx.autocommit || !tx.connected || tx.in_trans)
+		return;
+	if (!BeginTransaction(conn))
+		return;
+	MYLOG(0, "%p: transaction begun\n", conn);
+	tx.in_trans = TRUE;
+	set_state(conn, tx);
+}
+
+void
+TX_connected(ODBCConnection *conn)
+{
+	Transaction	tx = get_state(conn);
+
+	tx.connected = TRUE;
+	tx.in_trans = FALSE;
+	set_state(conn, tx);
+}
+
+void
+TX_disconnect(ODBCConnection *conn)
+{
+	Transaction	tx = get_state(conn);
+
+	if (tx.in_trans)
+		throw DriverException("Invalid transaction state", "25000");
+	tx.connected = FALSE;
+	set_state(conn, tx);
+}
+
+void
+TX_drop(ODBCConnection *conn)
+{
+	ConnectionExt	*ext = EX_conn(conn);
+	std::lock_guard<std::mutex>	lock(ext->lock);
+
+	delete ext->transaction;
+	ext->transaction = NULL;
+}
+
+BOOL
+TX_get_info(ODBCConnection *conn, SQLUSMALLINT type, PTR value, SQLSMALLINT *len)
+{
+	switch (type)
+	{
+		case SQL_TXN_CAPABLE:
+			if (SupportsTransactions(conn))
+				return FALSE;
+			if (value)
+				*((SQLUSMALLINT *) value) = SQL_TC_NONE;
+			if (len)
+				*len = sizeof(SQLUSMALLINT);
+			return TRUE;
+		case SQL_DEFAULT_TXN_ISOLATION:
+		case SQL_TXN_ISOLATION_OPTION:
+			if (SupportsTransactions(conn))
+				return FALSE;
+			if (value)
+				*((SQLUINTEGER *) value) = 0;
+			if (len)
+				*len = sizeof(SQLUINTEGER);
+			return TRUE;
+	}
+	return FALSE;
+}
@@ -0,0 +1,59 @@
+/* File:			transact.h
+ *
+ * Description:		See "transact.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __TRANSACT_H__
+#define __TRANSACT_H__
+
+#include "wdodbc.h"
+
+namespace ODBC
+{
+  class ODBCConnection;
+}
+
+/*
+ *	SQLSetConnectAttr and SQLGetConnectAttr of SQL_ATTR_AUTOCOMMIT.
+ *	Turning it on commits the open transaction; turning it off fails with HYC00
+ *	when the driver cannot run transactions.  Return FALSE, doing nothing, for
+ *	any other attribute.  Throw DriverException.
+ */
+BOOL	TX_set_attr(ODBC::ODBCConnection *conn, SQLINTEGER attr, PTR value);
+BOOL	TX_get_attr(ODBC::ODBCConnection *conn, SQLINTEGER attr, PTR value);
+
+/*
+ *	SQLEndTran of 'conn': commit or roll back its open transaction, the
+ *	next statement beginning another.  Nothing to do in autocommit mode.
+ *	Throws DriverException.
+ */
+RETCODE	TX_end(ODBC::ODBCConnection *conn, SQLSMALLINT completion);
+
+/*
+ *	A statement of 'conn' is about to run: in manual commit mode begin a
+ *	transaction unless one is open.  Throws
+ *	DriverException.
+ */
+void	TX_work(ODBC::ODBCConnection *conn);
+
+/*
+ *	'conn' connected, with no transaction open; it may not disconnect
+ *	with one open, throwing DriverException.  TX_drop() forgets a
+ *	connection being freed.
+ */
+void	TX_connected(ODBC::ODBCConnection *conn);
+void	TX_disconnect(ODBC::ODBCConnection *conn);
+void	TX_drop(ODBC::ODBCConnection *conn);
+
+/*
+ *	SQLGetInfo of SQL_TXN_CAPABLE, SQL_DEFAULT_TXN_ISOLATION and
+ *	SQL_TXN_ISOLATION_OPTION when the driver cannot run transactions on
+ *	'conn': none.  Returns FALSE, doing nothing, when it can, the server
+ *	then answering, or for any other type.
+ */
+BOOL	TX_get_info(ODBC::ODBCConnection *conn, SQLUSMALLINT type, PTR value, SQLSMALLINT *len);
+
+#endif /* __TRANSACT_H__ */
@@ -0,0 +1,397 @@
+/*-------
+ * Module:			txtconv.cc
+ *
+ * Description:		This module contains the parsing of character
+ *					parameters sent as numbers, dates and timestamps.
+ *
+ *					The parsers work on the application's bytes in place,
+ *					independently of the C locale.  Integers are read
+ *					exactly, whatever the notation of the literal.
+ *					Floating point literals take the exact fast path when
+ *					the digits and the power of ten are both exact doubles
+ *					(W. D. Clinger, "How to read floating point numbers
+ *					accurately", PLDI 1990); the others are handed to
+ *					strtod() rewritten without a decimal point, so that
+ *					the locale does not matter.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "txtconv.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Significant digits kept for strtod(); enough to round any double correctly */
+#define	MAX_SIG_DIGITS	800
+/* Exponents are clamped here while being read */
+#define	MAX_EXPONENT	100000
+
+static inline BOOL
+is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/* Drop leading and trailing blanks */
+static void
+trim(const char **s, size_t *len)
+{
+	const char	*p = *s, *e = *s + *len;
+
+	while (p < e && (' ' == *p || '\t' == *p))
+		p++;
+	while (e > p && (' ' == e[-1] || '\t' == e[-1]))
+		e--;
+	*s = p;
+	*len = (size_t) (e - p);
+}
+
+/*
+ *	Split a numeric literal [sign] digits [. digits] [(e|E) [sign] digits]
+ *	into its parts.  Returns FALSE when it is not one.
+ */
+typedef struct
+{
+	BOOL		negative;
+	const char	*int_digits;
+	size_t		int_len;
+	const char	*frac_digits;
+	size_t		frac_len;
+	int		exponent;
+} NumericLiteral;
+
+static BOOL
+split_literal(const char *s, size_t len, NumericLiteral *lit)
+{
+	const char	*p = s, *e = s + len;
+
+	lit->negative = FALSE;
+	lit->exponent = 0;
+	if (p < e && ('+' == *p || '-' == *p))
+		lit->negative = '-' == *p++;
+	lit->int_digits = p;
+	while (p < e && is_digit(*p))
+		p++;
+	lit->int_len = (size_t) (p - lit->int_digits);
+	lit->frac_digits = p;
+	lit->frac_len = 0;
+	if (p < e && '.' == *p)
+	{
+		lit->frac_digits = ++p;
+		while (p < e && is_digit(*p))
+			p++;
+		lit->frac_len = (size_t) (p - lit->frac_digits);
+	}
+	if (0 == lit->int_len + lit->frac_len)
+		return FALSE;
+	if (p < e && ('e' == *p || 'E' == *p))
+	{
+		BOOL	negexp = FALSE;
+		int	exponent = 0;
+
+		p++;
+		if (p < e && ('+' == *p || '-' == *p))
+			negexp = '-' == *p++;
+		if (p == e || !is_digit(*p))
+			return FALSE;
+		for (; p < e && is_digit(*p); p++)
+		{
+			if (exponent < MAX_EXPONENT)
+				exponent = exponent * 10 + (*p - '0');
+		}
+		lit->exponent = negexp ? -exponent : exponent;
+	}
+	return p == e;
+}
+
+/* Digit 'k' of the literal's mantissa, the integer digits followed by the fraction */
+static inline int
+mantissa_digit(const NumericLiteral *lit, size_t k)
+{
+	return (k < lit->int_len ? lit->int_digits[k] : lit->frac_digits[k - lit->int_len]) - '0';
+}
+
+int
+TX_parse_integer(const char *s, size_t len, BOOL *negative, uint64_t *magnitude)
+{
+	NumericLiteral	lit;
+	size_t		ndigits, k;
+	int64_t		point;
+	uint64_t	acc = 0;
+	BOOL		zero = TRUE;
+
+	trim(&s, &len);
+	if (!split_literal(s, len, &lit))
+		return COPY_INVALID_STRING_CONVERSION;
+	*negative = lit.negative;
+	*magnitude = 0;
+	ndigits = lit.int_len + lit.frac_len;
+	/* digits [0, point) make the integral part */
+	point = (int64_t) lit.int_len + lit.exponent;
+	for (k = 0; k < ndigits; k++)
+	{
+		int	d = mantissa_digit(&lit, k);
+
+		if (0 != d)
+			zero = FALSE;
+		if ((int64_t) k >= point)
+		{
+			if (0 != d)
+			{
+				*magnitude = acc;
+				return COPY_FRACTION_TRUNCATED;
+			}
+			continue;
+		}
+		if (acc > (UINT64_MAX - d) / 10)
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		acc = acc * 10 + d;
+	}
+	/* trailing zeros implied by the exponent */
+	for (; !zero && (int64_t) k < point; k++)
+	{
+		if (acc > UINT64_MAX / 10)
+			return COPY_NUMERIC_OUT_OF_RANGE;
+		acc *= 10;
+	}
+	*magnitude = acc;
+	return COPY_OK;
+}
+
+static BOOL
+match_word(const char *s, size_t len, const char *word)
+{
+	return strlen(word) == len && 0 == strnicmp(s, word, len);
+}
+
+int
+TX_parse_double(const char *s, size_t len, double *value)
+{
+	static const double exact_powers[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	NumericLiteral	lit;
+	char		digits[MAX_SIG_DIGITS + 16];
+	size_t		ndigits = 0, k, total;
+	int64_t		exponent;
+	BOOL		sticky = FALSE;
+
+	trim(&s, &len);
+	if (match_word(s, len, "NaN"))
+	{
+		*value = NAN;
+		return COPY_OK;
+	}
+	if (match_word(s, len, "Infinity") || match_word(s, len, "+Infinity"))
+	{
+		*value = HUGE_VAL;
+		return COPY_OK;
+	}
+	if (match_word(s, len, "-Infinity"))
+	{
+		*value = -HUGE_VAL;
+		return COPY_OK;
+	}
+	if (!split_literal(s, len, &lit))
+		return COPY_INVALID_STRING_CONVERSION;
+
+	/* value = 0.digits * 10^exponent, leading zeros skipped */
+	total = lit.int_len + lit.frac_len;
+	exponent = (int64_t) lit.int_len + lit.exponent;
+	for (k = 0; k < total; k++)
+	{
+		int	d = mantissa_digit(&lit, k);
+
+		if (0 == ndigits && 0 == d)
+		{
+			exponent--;
+			continue;
+		}
+		if (ndigits < MAX_SIG_DIGITS)
+			digits[ndigits++] = (char) ('0' + d);
+		else if (0 != d)
+			sticky = TRUE;
+	}
+	while (ndigits > 0 && '0' == digits[ndigits - 1])
+		ndigits--;
+	if (0 == ndigits)
+	{
+		*value = lit.negative ? -0.0 : 0.0;
+		return COPY_OK;
+	}
+	/* an integer mantissa from here on: value = digits * 10^exponent */
+	exponent -= (int64_t) ndigits;
+
+	if (ndigits <= 15 && exponent >= -22 && exponent <= 22)
+	{
+		uint64_t	mantissa = 0;
+		double		result;
+
+		for (k = 0; k < ndigits; k++)
+			mantissa = mantissa * 10 + (digits[k] - '0');
+		result = (double) mantissa;
+		if (exponent >= 0)
+			result *= exact_powers[exponent];
+		else
+			result /= exact_powers[-exponent];
+		*value = lit.negative ? -result : result;
+		return COPY_OK;
+	}
+
+	if (sticky)
+	{
+		/* a nonzero digit past the kept ones only matters for ties */
+		digits[ndigits++] = '1';
+		exponent--;
+	}
+	snprintf(digits + ndigits, sizeof(digits) - ndigits, "e%d", (int) exponent);
+	errno = 0;
+	*value = strtod(digits, NULL);
+	if (ERANGE == errno && fabs(*value) >= HUGE_VAL)
+		return COPY_NUMERIC_OUT_OF_RANGE;
+	if (lit.negative)
+		*value = -*value;
+	return COPY_OK;
+}
+
+/* Read exactly 'n' digits */
+static BOOL
+fixed_digits(const char **p, const char *e, int n, int *value)
+{
+	int	v = 0;
+
+	if (e - *p < n)
+		return FALSE;
+	for (; n > 0; n--, (*p)++)
+	{
+		if (!is_digit(**p))
+			return FALSE;
+		v = v * 10 + (**p - '0');
+	}
+	*value = v;
+	return TRUE;
+}
+
+static BOOL
+parse_time_part(const char **p, const char *e, SQL_TIMESTAMP_STRUCT *ts, BOOL *truncated)
+{
+	int	hh, mm, ss;
+
+	if (!fixed_digits(p, e, 2, &hh) || *p == e || ':' != *(*p)++
+	    || !fixed_digits(p, e, 2, &mm) || *p == e || ':' != *(*p)++
+	    || !fixed_digits(p, e, 2, &ss))
+		return FALSE;
+	if (hh > 23 || mm > 59 || ss > 59)
+		return FALSE;
+	ts->hour = (SQLUSMALLINT) hh;
+	ts->minute = (SQLUSMALLINT) mm;
+	ts->second = (SQLUSMALLINT) ss;
+	ts->fraction = 0;
+	if (*p < e && '.' == **p)
+	{
+		int	n = 0;
+
+		(*p)++;
+		if (*p == e || !is_digit(**p))
+			return FALSE;
+		for (; *p < e && is_digit(**p); (*p)++, n++)
+		{
+			if (n < 9)
+				ts->fraction = ts->fraction * 10 + (**p - '0');
+			else if ('0' != **p)
+				*truncated = TRUE;
+		}
+		for (; n < 9; n++)
+			ts->fraction *= 10;
+	}
+	return TRUE;
+}
+
+/* "Z", "+HH", "+HHMM" or "+HH:MM" */
+static BOOL
+parse_zone(const char **p, const char *e)
+{
+	int	hh, mm;
+
+	if (*p == e)
+		return TRUE;
+	if ('Z' == **p || 'z' == **p)
+	{
+		(*p)++;
+		return TRUE;
+	}
+	if ('+' != **p && '-' != **p)
+		return FALSE;
+	(*p)++;
+	if (!fixed_digits(p, e, 2, &hh))
+		return FALSE;
+	if (*p < e && ':' == **p)
+		(*p)++;
+	if (*p < e && !fixed_digits(p, e, 2, &mm))
+		return FALSE;
+	return TRUE;
+}
+
+static BOOL
+valid_date(int year, int month, int day)
+{
+	static const int days_in_month[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	int	last;
+
+	if (month < 1 || month > 12 || day < 1)
+		return FALSE;
+	last = days_in_month[month - 1];
+	if (2 == month && (0 == year % 4 && (0 != year % 100 || 0 == year % 400)))
+		last = 29;
+	return day <= last;
+}
+
+int
+TX_parse_datetime(const char *s, size_t len, SQL_TIMESTAMP_STRUCT *ts, int *kind)
+{
+	const char	*p, *e;
+	BOOL		truncated = FALSE;
+	int		year, month, day;
+
+	trim(&s, &len);
+	p = s;
+	e = s + len;
+	memset(ts, 0, sizeof(*ts));
+	*kind = 0;
+	/* a time starts with "HH:" */
+	if (len >= 3 && ':' == s[2])
+	{
+		if (!parse_time_part(&p, e, ts, &truncated) || !parse_zone(&p, e) || p != e)
+			return COPY_INVALID_STRING_CONVERSION;
+		*kind = TX_TIME;
+		return truncated ? COPY_FRACTION_TRUNCATED : COPY_OK;
+	}
+	if (!fixed_digits(&p, e, 4, &year) || p == e || '-' != *p++
+	    || !fixed_digits(&p, e, 2, &month) || p == e || '-' != *p++
+	    || !fixed_digits(&p, e, 2, &day) || !valid_date(year, month, day))
+		return COPY_INVALID_STRING_CONVERSION;
+	ts->year = (SQLSMALLINT) year;
+	ts->month = (SQLUSMALLINT) month;
+	ts->day = (SQLUSMALLINT) day;
+	*kind = TX_DATE;
+	if (p == e)
+		return COPY_OK;
+	if (' ' != *p && 'T' != *p && 't' != *p)
+		return COPY_INVALID_STRING_CONVERSION;
+	p++;
+	if (!parse_time_part(&p, e, ts, &truncated) || !parse_zone(&p, e) || p != e)
+		return COPY_INVALID_STRING_CONVERSION;
+	*kind = TX_TIMESTAMP;
+	return truncated ? COPY_FRACTION_TRUNCATED : COPY_OK;
+}
@@ -0,0 +1,47 @@
+/* File:			txtconv.h
+ *
+ * Description:		See "txtconv.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __TXTCONV_H__
+#define __TXTCONV_H__
+
+#include "colconv.h"
+
+/*
+ *	Scalar parsers.  They read exactly 'len' characters, ignoring leading
+ *	and trailing blanks, use '.' as the decimal point whatever the locale
+ *	and never allocate.  Results are COPY_xxx codes:
+ *
+ *		COPY_INVALID_STRING_CONVERSION	not a literal of the kind (22018)
+ *		COPY_NUMERIC_OUT_OF_RANGE	the value does not fit (22003)
+ *		COPY_FRACTION_TRUNCATED		fractional digits were dropped (01S07)
+ *
+ *	TX_parse_integer accepts any numeric literal ("12", "-1.5", "2e3") and
+ *	returns its integral part as a sign and a magnitude.
+ */
+int	TX_parse_integer(const char *s, size_t len, BOOL *negative, uint64_t *magnitude);
+/*
+ *	Correctly rounded; "NaN", "Infinity" and "-Infinity" are accepted as
+ *	well.
+ */
+int	TX_parse_double(const char *s, size_t len, double *value);
+
+/* What TX_parse_datetime found */
+#define	TX_DATE		1
+#define	TX_TIME		2
+#define	TX_TIMESTAMP	(TX_DATE | TX_TIME)
+
+/*
+ *	Parse an ISO-8601 date ("YYYY-MM-DD"), time ("HH:MM:SS[.fffffffff]")
+ *	or timestamp (the two separated by a blank or 'T').  A trailing zone
+ *	designator ("Z", "+05:30") is accepted and the value kept as written.
+ *	'*kind' is set to TX_DATE, TX_TIME or TX_TIMESTAMP; the fields not
+ *	present are zero.  Fraction digits past nanoseconds are truncated.
+ */
+int	TX_parse_datetime(const char *s, size_t len, SQL_TIMESTAMP_STRUCT *ts, int *kind);
+
+#endif /* __TXTCONV_H__ */
@@ -0,0 +1,71 @@
+/*-------
+ * Module:			utf8check.cc
+ *
+ * Description:		This module contains the validation of utf8 text, as
+ *					character parameters are checked before they are sent.
+ *
+ * Classes:			n/a
+ *
+ * API functions:	none
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ *-------
+ */
+
+#include "utf8check.h"
+
+/* Step '*pos' over the multibyte character there; FALSE when it is not well formed */
+static inline BOOL
+step_sequence(const UCHAR *s, size_t len, size_t *pos)
+{
+	size_t	i = *pos, need, k;
+	UCHAR	c = s[i], lo = 0x80, hi = 0xbf;
+
+	if (c >= 0xc2 && c <= 0xdf)
+		need = 1;
+	else if (c >= 0xe0 && c <= 0xef)
+	{
+		need = 2;
+		if (0xe0 == c)
+			lo = 0xa0;
+		else if (0xed == c)
+			hi = 0x9f;
+	}
+	else if (c >= 0xf0 && c <= 0xf4)
+	{
+		need = 3;
+		if (0xf0 == c)
+			lo = 0x90;
+		else if (0xf4 == c)
+			hi = 0x8f;
+	}
+	else
+		return FALSE;
+	for (k = 1; k <= need; k++)
+	{
+		/* only the second byte has narrower bounds */
+		if (i + k >= len || s[i + k] < lo || s[i + k] > hi)
+			return FALSE;
+		lo = 0x80;
+		hi = 0xbf;
+	}
+	*pos = i + k;
+	return TRUE;
+}
+
+BOOL
+U8_validate(const char *str, size_t len)
+{
+	const UCHAR	*s = (const UCHAR *) str;
+	size_t	pos = 0;
+
+	while (pos < len)
+	{
+		if (s[pos] < 0x80)
+			pos++;
+		else if (!step_sequence(s, len, &pos))
+			return FALSE;
+	}
+	return TRUE;
+}
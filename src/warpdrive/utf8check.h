@@ -0,0 +1,22 @@
+/* File:			utf8check.h
+ *
+ * Description:		See "utf8check.cc"
+ *
+ * Comments:		See "readme.txt" for copyright and license information.
+ *                      Modifications to this file by Dremio Corporation, (C) 2020-2022.
+ */
+
+#ifndef __UTF8CHECK_H__
+#define __UTF8CHECK_H__
+
+#include "wdodbc.h"
+
+#include <stddef.h>
+
+/*
+ *	TRUE when 'len' bytes of 's' are well formed utf8: no overlong forms,
+ *	surrogates, code points past U+10FFFF or truncated sequences.
+ */
+BOOL	U8_validate(const char *s, size_t len);
+
+#endif /* __UTF8CHECK_H__ */
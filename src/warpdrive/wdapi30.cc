@@ -33,6 +33,11 @@
 #include "wdapifunc.h"
 #include "loadlib.h"
 #include "dlg_specific.h"
+#include "paramset.h"
+#include "asyncexec.h"
+#include "conntime.h"
+#include "odbcescape.h"
+#include "transact.h"
 
 #include <odbcabstraction/odbc_impl/AttributeUtils.h>
 #include <odbcabstraction/odbc_impl/ODBCEnvironment.h>
@@ -413,6 +418,14 @@ RETCODE SQL_API WD_GetConnectAttr(HDBC ConnectionHandle, SQLINTEGER Attribute,
 
   MYLOG(0, "entering Handle=%p " FORMAT_INTEGER "\n", ConnectionHandle, Attribute);
   ODBCConnection* conn = reinterpret_cast<ODBCConnection*>(ConnectionHandle);
+  if (AE_get_conn_attr(conn, Attribute, Value) ||
+      CT_get_attr(conn, Attribute, Value) ||
+      TX_get_attr(conn, Attribute, Value))
+  {
+    if (StringLength)
+      *StringLength = sizeof(SQLULEN);
+    return ret;
+  }
   conn->GetConnectAttr(Attribute, Value, BufferLength, StringLength, isUnicode);
   return ret;
 }
@@ -1500,6 +1513,10 @@ RETCODE SQL_API WD_GetStmtAttr(HSTMT StatementHandle, SQLINTEGER Attribute,
 
     MYLOG(0, "entering Handle=%p " FORMAT_INTEGER "\n", StatementHandle, Attribute);
     ODBCStatement* statement = reinterpret_cast<ODBCStatement*>(StatementHandle);
+    if (PS_get_attr(statement, Attribute, Value) ||
+        AE_get_attr(statement, Attribute, Value) ||
+        ES_get_attr(statement, Attribute, Value))
+        return ret;
     statement->GetStmtAttr(Attribute, Value, BufferLength, StringLength, isUnicode);
     return ret;
 }
@@ -1515,6 +1532,10 @@ WD_SetConnectAttr(HDBC ConnectionHandle,
   RETCODE	ret = SQL_SUCCESS;
 
   MYLOG(0, "entering for %p: " FORMAT_INTEGER " %p\n", ConnectionHandle, Attribute, Value);
+  if (AE_set_conn_attr(conn, Attribute, Value) ||
+      CT_set_attr(Attribute) ||
+      TX_set_attr(conn, Attribute, Value))
+    return ret;
   conn->SetConnectAttr(Attribute, Value, StringLength, isUnicode);
   return ret;
 }
@@ -1627,6 +1648,15 @@ RETCODE SQL_API WD_SetStmtAttr(HSTMT StatementHandle, SQLINTEGER Attribute,
 
   MYLOG(0, "entering Handle=%p " FORMAT_INTEGER "\n", StatementHandle, Attribute);
   ODBCStatement* statement = reinterpret_cast<ODBCStatement*>(StatementHandle);
+  /* parameter arrays are handled here, see paramset.cc */
+  if (PS_set_attr(statement, Attribute, Value))
+    return ret;
+  /* asynchronous execution is handled here, see asyncexec.cc */
+  if (AE_set_attr(statement, Attribute, Value))
+    return ret;
+  /* escape sequences are rewritten here, see odbcescape.cc */
+  if (ES_set_attr(statement, Attribute, Value))
+    return ret;
   statement->SetStmtAttr(Attribute, Value, StringLength, isUnicode);
   return ret;
 }
@@ -25,6 +25,7 @@
 #define	PODBC_WITH_HOLD			1L
 #define	PODBC_RDONLY			(1L << 1)
 #define	PODBC_RECYCLE_STATEMENT		(1L << 2)
+#define	PODBC_BATCH_MEMBER		(1L << 3)	/* from SQLMoreResults, not split again */
 /*	Flags for the error handling */
 #define	PODBC_ALLOW_PARTIAL_EXTRACT	1L
 /* #define	PODBC_ERROR_CLEAR		(1L << 1) 	no longer used */
@@ -305,6 +306,30 @@ enum {
 	,SQL_ATTR_PGOPT_BATCHSIZE = 65550
 	,SQL_ATTR_PGOPT_IGNORETIMEOUT = 65551
 };
+/*
+ * Driver-specific connection attributes, read only, timing the last
+ * connection and disconnection in microseconds.  The connect time covers
+ * the whole of SQLConnect or SQLDriverConnect; its name resolution, TLS
+ * handshake and authentication are not timed apart.
+ */
+enum {
+	SQL_ATTR_WD_CONNECT_TIME = 65620
+	,SQL_ATTR_WD_DISCONNECT_TIME = 65621
+};
+/*
+ * Driver-specific statement attributes, for SQLSet/GetStmtAttr().
+ *
+ * SQL_ATTR_WD_PARAM_STREAM takes a struct ArrowArrayStream * (Arrow C stream
+ * interface) with a field per parameter marker.  The driver moves the stream
+ * out and the next SQLExecute uses it up instead of the bound parameters,
+ * rendering the rows of each batch into the statement as literals, as
+ * bound parameters are.  Timestamps with a named time zone fail with
+ * HYC00; no zone, UTC and fixed offsets are written as their wall clock
+ * time.
+ */
+enum {
+	SQL_ATTR_WD_PARAM_STREAM = 65600
+};
 RETCODE SQL_API WD_SetConnectAttr(HDBC ConnectionHandle,
 			SQLINTEGER Attribute, PTR Value,
 			SQLINTEGER StringLength, bool isUnicode);